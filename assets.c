@@ -0,0 +1,131 @@
+#include "assets.h"
+#include <string.h>
+
+static void *AssetWorker(void *context) {
+    AssetLoader *loader = context;
+
+    for (int i = 0; i < loader->requestCount; i++) {
+        pthread_mutex_lock(&loader->lock);
+        bool cancel = loader->cancel;
+        pthread_mutex_unlock(&loader->lock);
+        if (cancel) break;
+
+        // Only file IO and decoding here: anything touching the audio device stays on the main thread
+        AssetRequest *request = &loader->requests[i];
+        if (request->kind == ASSET_SOUND) {
+            request->wave = LoadWave(request->path);
+            request->failed = request->wave.data == NULL;
+        } else {
+            request->fileData = LoadFileData(request->path, &request->fileSize);
+            request->failed = request->fileData == NULL;
+        }
+
+        pthread_mutex_lock(&loader->lock);
+        loader->completed[loader->completedCount++] = i;
+        pthread_mutex_unlock(&loader->lock);
+    }
+    return NULL;
+}
+
+void InitAssetLoader(AssetLoader *loader) {
+    memset(loader, 0, sizeof(AssetLoader));
+    pthread_mutex_init(&loader->lock, NULL);
+}
+
+static void QueueAsset(AssetLoader *loader, AssetKind kind, const char *path, void *target) {
+    if (loader->started || loader->requestCount >= MAX_ASSETS) {
+        TraceLog(LOG_WARNING, "ASSETS: Cannot queue %s", path);
+        return;
+    }
+    AssetRequest *request = &loader->requests[loader->requestCount++];
+    request->kind = kind;
+    request->path = path;
+    request->target = target;
+}
+
+void QueueSoundAsset(AssetLoader *loader, const char *path, Sound *target) {
+    QueueAsset(loader, ASSET_SOUND, path, target);
+}
+
+void QueueMusicAsset(AssetLoader *loader, const char *path, Music *target) {
+    QueueAsset(loader, ASSET_MUSIC, path, target);
+}
+
+void StartAssetLoader(AssetLoader *loader) {
+    loader->startTime = GetTime();
+    if (pthread_create(&loader->worker, NULL, AssetWorker, loader) == 0) {
+        loader->started = true;
+    } else {
+        // No thread available: decode everything now rather than never
+        TraceLog(LOG_WARNING, "ASSETS: Failed to start loader thread, loading synchronously");
+        AssetWorker(loader);
+    }
+}
+
+static void UploadAsset(AssetRequest *request) {
+    if (request->failed) {
+        TraceLog(LOG_WARNING, "ASSETS: Failed to load %s", request->path);
+        return;
+    }
+
+    if (request->kind == ASSET_SOUND) {
+        *(Sound *)request->target = LoadSoundFromWave(request->wave);
+        UnloadWave(request->wave);
+        request->wave = (Wave){0};
+    } else {
+        const char *extension = strrchr(request->path, '.');
+        *(Music *)request->target = LoadMusicStreamFromMemory(extension ? extension : "", request->fileData,
+                                                              request->fileSize);
+    }
+}
+
+int PollAssetLoader(AssetLoader *loader) {
+    if (AreAssetsReady(loader)) return 0;
+
+    pthread_mutex_lock(&loader->lock);
+    int completedCount = loader->completedCount;
+    pthread_mutex_unlock(&loader->lock);
+
+    int uploaded = 0;
+    while (loader->uploadedCount < completedCount) {
+        UploadAsset(&loader->requests[loader->completed[loader->uploadedCount++]]);
+        uploaded++;
+    }
+
+    if (AreAssetsReady(loader)) {
+        loader->readyTime = GetTime() - loader->startTime;
+        TraceLog(LOG_INFO, "STARTUP: %d assets ready after %.1f ms (%.1f ms loading)", loader->requestCount,
+                 GetTime() * 1000.0, loader->readyTime * 1000.0);
+    }
+    return uploaded;
+}
+
+bool AreAssetsReady(const AssetLoader *loader) {
+    return loader->uploadedCount == loader->requestCount;
+}
+
+float GetAssetProgress(const AssetLoader *loader) {
+    if (loader->requestCount == 0) return 1.0f;
+    return (float)loader->uploadedCount / loader->requestCount;
+}
+
+void UnloadAssetLoader(AssetLoader *loader) {
+    if (loader->started) {
+        pthread_mutex_lock(&loader->lock);
+        loader->cancel = true;
+        pthread_mutex_unlock(&loader->lock);
+        pthread_join(loader->worker, NULL);
+        loader->started = false;
+    }
+
+    // Decoded but never uploaded
+    for (int i = loader->uploadedCount; i < loader->completedCount; i++) {
+        AssetRequest *request = &loader->requests[loader->completed[i]];
+        if (request->wave.data) UnloadWave(request->wave);
+    }
+    // Music streams read from this memory, so it goes last
+    for (int i = 0; i < loader->requestCount; i++) {
+        if (loader->requests[i].fileData) UnloadFileData(loader->requests[i].fileData);
+    }
+    pthread_mutex_destroy(&loader->lock);
+}
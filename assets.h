@@ -0,0 +1,55 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "raylib.h"
+#include <pthread.h>
+#include <stdbool.h>
+
+#define MAX_ASSETS 32
+
+typedef enum {
+    ASSET_SOUND,  // Fully decoded on the worker, uploaded with LoadSoundFromWave
+    ASSET_MUSIC   // File read on the worker, streamed from memory once uploaded
+} AssetKind;
+
+typedef struct {
+    AssetKind kind;
+    const char *path;
+    void *target;            // Sound* or Music*, written on the main thread only
+    // Worker output, handed over through the completion queue
+    Wave wave;
+    unsigned char *fileData; // Music keeps this alive until UnloadAssetLoader
+    int fileSize;
+    bool failed;
+} AssetRequest;
+
+// Decodes audio on a background thread so the window stays responsive during startup.
+// Queue every asset, start the worker, then call PollAssetLoader once per frame: finished
+// decodes are uploaded on the calling thread and written to their targets.
+typedef struct {
+    AssetRequest requests[MAX_ASSETS];
+    int requestCount;
+    int completed[MAX_ASSETS];   // Completion queue: indices of decoded requests, in order
+    int completedCount;          // Guarded by lock
+    int uploadedCount;           // Main thread only
+    bool cancel;                 // Guarded by lock
+    pthread_mutex_t lock;
+    pthread_t worker;
+    bool started;
+    double startTime;            // GetTime() when the worker started
+    double readyTime;            // Seconds from startTime until every asset was uploaded
+} AssetLoader;
+
+void InitAssetLoader(AssetLoader *loader);
+void QueueSoundAsset(AssetLoader *loader, const char *path, Sound *target);
+void QueueMusicAsset(AssetLoader *loader, const char *path, Music *target);
+void StartAssetLoader(AssetLoader *loader);
+// Uploads everything the worker has finished. Returns how many assets arrived this call.
+int PollAssetLoader(AssetLoader *loader);
+bool AreAssetsReady(const AssetLoader *loader);
+float GetAssetProgress(const AssetLoader *loader);
+// Stops the worker and frees anything it decoded that was never uploaded. The uploaded
+// sounds and music belong to their targets and are unloaded by their owner first.
+void UnloadAssetLoader(AssetLoader *loader);
+
+#endif
@@ -0,0 +1,185 @@
+#include "audio.h"
+#include "raymath.h"
+#include <stdlib.h>
+#include <string.h>
+
+void InitAudioMixer(AudioMixer *mixer) {
+    memset(mixer, 0, sizeof(AudioMixer));
+}
+
+void SetAudioCue(AudioMixer *mixer, AudioCue cue, const Sound *variants, int variantCount, int priority,
+                 float volume, float maxDistance) {
+    AudioCueVoices *voices = &mixer->cues[cue];
+    if (variantCount > MAX_AUDIO_CUE_VARIANTS) variantCount = MAX_AUDIO_CUE_VARIANTS;
+
+    for (int v = 0; v < variantCount; v++) {
+        for (int i = 0; i < AUDIO_VOICES_PER_VARIANT; i++) {
+            // Aliases share the source's sample data; each only adds playback state
+            voices->voices[v][i] = LoadSoundAlias(variants[v]);
+        }
+    }
+    voices->variantCount = variantCount;
+    voices->priority = priority;
+    voices->volume = volume;
+    voices->maxDistance = maxDistance;
+}
+
+void PlayAudioCue(AudioMixer *mixer, AudioCue cue, Vector3 position, float volume) {
+    AudioRequest *request = &mixer->requests[cue];
+    mixer->current.requested++;
+
+    if (!request->pending) {
+        *request = (AudioRequest){true, position, volume};
+        return;
+    }
+
+    // Same cue twice in one frame sounds like one louder play; keep one voice for it, placed
+    // where the loudest request was
+    mixer->current.merged++;
+    if (volume > request->volume) {
+        request->volume = volume;
+        request->position = position;
+    }
+}
+
+// Pan value for a source on the listener's left (-1) to right (1)
+static float SoundPan(float side) {
+#if RAYLIB_VERSION_MAJOR > 5 || (RAYLIB_VERSION_MAJOR == 5 && RAYLIB_VERSION_MINOR >= 5)
+    return side;  // -1.0 left, 0.0 center, 1.0 right
+#else
+    return 0.5f - 0.5f * side;  // 1.0 left, 0.5 center, 0.0 right
+#endif
+}
+
+static int CountActiveVoices(const AudioMixer *mixer) {
+    int active = 0;
+    for (int c = 0; c < AUDIO_CUE_COUNT; c++) {
+        const AudioCueVoices *voices = &mixer->cues[c];
+        for (int v = 0; v < voices->variantCount; v++) {
+            for (int i = 0; i < AUDIO_VOICES_PER_VARIANT; i++) {
+                if (IsSoundPlaying(voices->voices[v][i])) active++;
+            }
+        }
+    }
+    return active;
+}
+
+// Stops the oldest playing voice of the lowest-priority cue below `priority`. Returns false if none.
+static bool StealVoice(AudioMixer *mixer, int priority) {
+    Sound *victim = NULL;
+    int victimPriority = priority;
+    unsigned int victimStarted = 0;
+
+    for (int c = 0; c < AUDIO_CUE_COUNT; c++) {
+        AudioCueVoices *voices = &mixer->cues[c];
+        if (voices->priority > victimPriority) continue;
+        for (int v = 0; v < voices->variantCount; v++) {
+            for (int i = 0; i < AUDIO_VOICES_PER_VARIANT; i++) {
+                if (!IsSoundPlaying(voices->voices[v][i])) continue;
+                bool lower = voices->priority < victimPriority;
+                if (lower || (victim && voices->voiceStarted[v][i] < victimStarted)) {
+                    victim = &voices->voices[v][i];
+                    victimPriority = voices->priority;
+                    victimStarted = voices->voiceStarted[v][i];
+                }
+            }
+        }
+    }
+
+    if (!victim) return false;
+    StopSound(*victim);
+    return true;
+}
+
+typedef struct {
+    AudioCue cue;
+    int priority;
+    float gain;
+    float pan;
+} AudioPlay;
+
+void UpdateAudioMixer(AudioMixer *mixer, Camera listener) {
+    Vector3 forward = Vector3Subtract(listener.target, listener.position);
+    Vector3 right = Vector3Normalize(Vector3CrossProduct(forward, listener.up));
+    AudioPlay plays[AUDIO_CUE_COUNT];
+    int playCount = 0;
+
+    // Attenuate and cull, then order by priority and loudness
+    for (int c = 0; c < AUDIO_CUE_COUNT; c++) {
+        AudioRequest *request = &mixer->requests[c];
+        if (!request->pending) continue;
+        request->pending = false;
+
+        AudioCueVoices *voices = &mixer->cues[c];
+        float gain = voices->volume * request->volume;
+        float pan = SoundPan(0.0f);
+        if (voices->maxDistance > 0.0f) {
+            Vector3 offset = Vector3Subtract(request->position, listener.position);
+            float distance = Vector3Length(offset);
+            gain *= 1.0f - distance / voices->maxDistance;
+            if (distance > 0.001f) pan = SoundPan(Vector3DotProduct(offset, right) / distance);
+        }
+        if (voices->variantCount == 0 || gain < AUDIO_MIN_GAIN) {
+            mixer->current.culled++;
+            continue;
+        }
+
+        int i = playCount++;
+        while (i > 0 && (plays[i - 1].priority < voices->priority ||
+                         (plays[i - 1].priority == voices->priority && plays[i - 1].gain < gain))) {
+            plays[i] = plays[i - 1];
+            i--;
+        }
+        plays[i] = (AudioPlay){c, voices->priority, gain, pan};
+    }
+
+    int active = CountActiveVoices(mixer);
+    for (int p = 0; p < playCount; p++) {
+        AudioCueVoices *voices = &mixer->cues[plays[p].cue];
+        int variant = rand() % voices->variantCount;
+
+        // A free alias of the clip, or else restart the clip's oldest one (no change in voice count)
+        int slot = 0;
+        bool reuse = true;
+        for (int i = 0; i < AUDIO_VOICES_PER_VARIANT; i++) {
+            if (!IsSoundPlaying(voices->voices[variant][i])) {
+                slot = i;
+                reuse = false;
+                break;
+            }
+            if (voices->voiceStarted[variant][i] < voices->voiceStarted[variant][slot]) slot = i;
+        }
+
+        if (!reuse && active >= AUDIO_VOICE_BUDGET) {
+            if (!StealVoice(mixer, plays[p].priority)) {
+                mixer->current.culled++;
+                continue;
+            }
+            mixer->current.stolen++;
+            active--;
+        }
+
+        Sound voice = voices->voices[variant][slot];
+        SetSoundVolume(voice, plays[p].gain);
+        SetSoundPan(voice, plays[p].pan);
+        PlaySound(voice);
+        voices->voiceStarted[variant][slot] = mixer->frame;
+        if (!reuse) active++;
+        mixer->current.played++;
+    }
+
+    mixer->current.activeVoices = active;
+    mixer->stats = mixer->current;
+    mixer->current = (AudioStats){0};
+    mixer->frame++;
+}
+
+void UnloadAudioMixer(AudioMixer *mixer) {
+    for (int c = 0; c < AUDIO_CUE_COUNT; c++) {
+        AudioCueVoices *voices = &mixer->cues[c];
+        for (int v = 0; v < voices->variantCount; v++) {
+            for (int i = 0; i < AUDIO_VOICES_PER_VARIANT; i++) UnloadSoundAlias(voices->voices[v][i]);
+        }
+        voices->variantCount = 0;
+    }
+}
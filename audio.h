@@ -0,0 +1,64 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include "raylib.h"
+
+#define MAX_AUDIO_CUE_VARIANTS 2
+#define AUDIO_VOICES_PER_VARIANT 4   // Aliases per clip, so overlapping plays do not cut each other off
+#define AUDIO_VOICE_BUDGET 12        // Voices mixed at once across every cue
+#define AUDIO_MIN_GAIN 0.02f         // Quieter than this after distance falloff is not worth a voice
+
+typedef enum {
+    AUDIO_CUE_THROW,
+    AUDIO_CUE_ENEMY_HIT,
+    AUDIO_CUE_ENEMY_DEATH,
+    AUDIO_CUE_PLAYER_HIT,
+    AUDIO_CUE_PLAYER_DEATH,
+    AUDIO_CUE_COUNT
+} AudioCue;
+
+typedef struct {
+    Sound voices[MAX_AUDIO_CUE_VARIANTS][AUDIO_VOICES_PER_VARIANT];  // Aliases of each variant's clip
+    unsigned int voiceStarted[MAX_AUDIO_CUE_VARIANTS][AUDIO_VOICES_PER_VARIANT];  // Frame, for reusing the oldest
+    int variantCount;
+    int priority;        // A cue may steal a voice from any lower-priority cue when over budget
+    float volume;
+    float maxDistance;   // Silent beyond this; 0 for cues heard everywhere, unpanned
+} AudioCueVoices;
+
+// One frame's plays of a cue, merged
+typedef struct {
+    bool pending;
+    Vector3 position;    // Of the loudest merged play
+    float volume;        // Loudest of the merged plays
+} AudioRequest;
+
+typedef struct {
+    int requested;       // PlayAudioCue calls
+    int merged;          // Dropped as duplicates of a cue already requested this frame
+    int culled;          // Too far, too quiet or outranked when the budget was full
+    int played;
+    int stolen;          // Voices stopped early for a higher-priority cue
+    int activeVoices;
+} AudioStats;
+
+// Fixed pool of sound aliases. Game code requests cues during the frame; UpdateAudioMixer
+// then plays at most one sound per cue, in priority order, within AUDIO_VOICE_BUDGET.
+typedef struct {
+    AudioCueVoices cues[AUDIO_CUE_COUNT];
+    AudioRequest requests[AUDIO_CUE_COUNT];
+    AudioStats stats;    // Last completed update
+    AudioStats current;  // Being gathered this frame
+    unsigned int frame;
+} AudioMixer;
+
+void InitAudioMixer(AudioMixer *mixer);
+// Creates the voices for a cue from loaded sounds. The sources must outlive the mixer.
+void SetAudioCue(AudioMixer *mixer, AudioCue cue, const Sound *variants, int variantCount, int priority,
+                 float volume, float maxDistance);
+void PlayAudioCue(AudioMixer *mixer, AudioCue cue, Vector3 position, float volume);
+// Resolves this frame's requests against the listener and starts the winners
+void UpdateAudioMixer(AudioMixer *mixer, Camera listener);
+void UnloadAudioMixer(AudioMixer *mixer);
+
+#endif
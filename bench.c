@@ -0,0 +1,388 @@
+// Microbenchmarks for the simulation hot paths.
+//
+// Each benchmark runs at 15, 1k and 100k entities from a fixed seed, so runs are comparable
+// across machines and releases. Results go to stdout as a table and, optionally, to JSON
+// and CSV files for regression tracking:
+//
+//   frisbee_bench [--samples N] [--seed S] [--threads N] [--json out.json] [--csv out.csv]
+//
+// --threads runs the parallel passes on N threads (the default, 1, keeps everything serial),
+// so the same suite measures scaling.
+
+#include "sim.h"
+#include "raymath.h"
+#include "jobs.h"
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_SAMPLES 30
+#define BENCH_DEFAULT_SEED 1
+#define BENCH_WARMUP_SAMPLES 2       // Run first and thrown away, to warm caches and the allocator
+#define BENCH_MIN_WORK 20000         // Entity updates per sample, so tiny counts are not all clock overhead
+#define BENCH_DT SIM_TICK_DT
+#define MAX_BENCH_RESULTS 32
+
+static const int benchCounts[] = {15, 1000, 100000};
+#define BENCH_COUNT_COUNT (int)(sizeof(benchCounts) / sizeof(benchCounts[0]))
+
+typedef struct {
+    const char *name;
+    int entities;      // Entities processed per call
+    int iterations;    // Calls per sample
+    int samples;
+    double meanNs;     // Per call
+    double stddevNs;
+    double minNs;
+    double medianNs;
+    // Spatial hash queries, for the collision benchmarks; 0 queries for the rest
+    int queries;         // Per call
+    double candidatesPerQuery;
+    int maxCandidates;
+} BenchResult;
+
+typedef struct {
+    int samples;
+    unsigned int seed;
+    int threads;
+    const StaticWorld *world;
+    BenchResult results[MAX_BENCH_RESULTS];
+    int resultCount;
+} Bench;
+
+static double NowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int CompareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int IterationsFor(int entities) {
+    int iterations = BENCH_MIN_WORK / entities;
+    return iterations > 0 ? iterations : 1;
+}
+
+// Turns per-sample totals into per-call statistics and records them, with the spatial hash
+// queries the timed calls made when `queries` is given
+static void RecordResult(Bench *bench, const char *name, int entities, int iterations, double *sampleNs,
+                         const SpatialHashStats *queries) {
+    int n = bench->samples;
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) {
+        sampleNs[i] /= iterations;
+        sum += sampleNs[i];
+    }
+    double mean = sum / n;
+    double squares = 0.0;
+    for (int i = 0; i < n; i++) squares += (sampleNs[i] - mean) * (sampleNs[i] - mean);
+    qsort(sampleNs, n, sizeof(double), CompareDoubles);
+
+    if (bench->resultCount >= MAX_BENCH_RESULTS) return;
+    BenchResult *result = &bench->results[bench->resultCount++];
+    bool queried = queries && queries->queries > 0;
+    *result = (BenchResult){
+        .name = name,
+        .entities = entities,
+        .iterations = iterations,
+        .samples = n,
+        .meanNs = mean,
+        .stddevNs = n > 1 ? sqrt(squares / (n - 1)) : 0.0,
+        .minNs = sampleNs[0],
+        .medianNs = sampleNs[n / 2],
+        .queries = queried ? queries->queries / (iterations * n) : 0,
+        .candidatesPerQuery = queried ? (double)queries->candidatesTested / queries->queries : 0.0,
+        .maxCandidates = queried ? queries->maxCandidates : 0,
+    };
+}
+
+// A store holding one archetype of enemies, and the manager that runs them
+typedef struct {
+    EntityStore store;
+    EnemyManager manager;
+} Crowd;
+
+// Scatters `count` enemies uniformly over the arena. Spawning stops at what fits with
+// ENEMY_SPAWN_SPACING, well short of 100k in one arena, so the crowd is placed directly and
+// overlaps where it is dense; the hot paths are measured at the full count.
+static void MakeEnemies(Bench *bench, Crowd *crowd, int count) {
+    uint32_t rng = SeedRandom(bench->seed);
+    InitEntityStore(&crowd->store);
+    crowd->manager = InitEnemyManager(&crowd->store, bench->world, 0, &rng);
+    ReserveEnemies(&crowd->manager, &crowd->store, count);
+    float reach = bench->world->halfSize - ENEMY_SPAWN_WALL_MARGIN;
+    for (int i = 0; i < count; i++) {
+        float x = ((float)NextRandom(&rng) / 0x7fffffff * 2.0f - 1.0f) * reach;
+        float z = ((float)NextRandom(&rng) / 0x7fffffff * 2.0f - 1.0f) * reach;
+        AddEnemy(&crowd->manager, &crowd->store, (Vector3){x, 0.0f, z}, 0.0f);
+    }
+}
+
+static void UnloadCrowd(Crowd *crowd) {
+    UnloadEnemyManager(&crowd->manager);
+    UnloadEntityStore(&crowd->store);
+}
+
+static Archetype *GetCrowdEnemies(Crowd *crowd) {
+    return &crowd->store.archetypes[crowd->manager.archetype];
+}
+
+static void BenchInitEnemyManager(Bench *bench, int count, double *sampleNs) {
+    // Always one call per sample: a sample at 15 enemies is still far above clock resolution.
+    // Past what the arena holds, fewer are spawned; the result counts those.
+    int spawned = 0;
+    for (int s = -BENCH_WARMUP_SAMPLES; s < bench->samples; s++) {
+        uint32_t rng = SeedRandom(bench->seed);
+        EntityStore store;
+        InitEntityStore(&store);
+        double start = NowNs();
+        EnemyManager manager = InitEnemyManager(&store, bench->world, count, &rng);
+        if (s >= 0) sampleNs[s] = NowNs() - start;
+        spawned = CountEntities(&store, TARGET_COMPONENTS);
+        UnloadEnemyManager(&manager);
+        UnloadEntityStore(&store);
+    }
+    RecordResult(bench, "InitEnemyManager", spawned > 0 ? spawned : 1, 1, sampleNs, NULL);
+}
+
+static void BenchUpdateEnemies(Bench *bench, int count, double *sampleNs) {
+    Crowd crowd;
+    MakeEnemies(bench, &crowd, count);
+    Archetype *enemies = GetCrowdEnemies(&crowd);
+    float *startX = malloc(sizeof(float) * count);
+    float *startZ = malloc(sizeof(float) * count);
+    memcpy(startX, enemies->columns[COMPONENT_POSITION_X], sizeof(float) * count);
+    memcpy(startZ, enemies->columns[COMPONENT_POSITION_Z], sizeof(float) * count);
+    Vector3 playerPosition = {0.0f, 1.7f, 0.0f};
+    int iterations = IterationsFor(count);
+
+    for (int s = -BENCH_WARMUP_SAMPLES; s < bench->samples; s++) {
+        // Start every sample from the spawn layout so the crowd has not collapsed onto the player;
+        // the spatial hash relinks moved enemies on the next update
+        memcpy(enemies->columns[COMPONENT_POSITION_X], startX, sizeof(float) * count);
+        memcpy(enemies->columns[COMPONENT_POSITION_Z], startZ, sizeof(float) * count);
+        double start = NowNs();
+        for (int i = 0; i < iterations; i++) {
+            UpdateEnemies(&crowd.manager, &crowd.store, bench->world, playerPosition, BENCH_DT);
+        }
+        if (s >= 0) sampleNs[s] = NowNs() - start;
+    }
+    RecordResult(bench, "UpdateEnemies", count, iterations, sampleNs, NULL);
+
+    free(startX);
+    free(startZ);
+    UnloadCrowd(&crowd);
+}
+
+static void BenchEnemyPlayerCollision(Bench *bench, int count, double *sampleNs) {
+    Crowd crowd;
+    MakeEnemies(bench, &crowd, count);
+    Archetype *enemies = GetCrowdEnemies(&crowd);
+    const float *xs = enemies->columns[COMPONENT_POSITION_X];
+    const float *zs = enemies->columns[COMPONENT_POSITION_Z];
+    // Stand the player on an enemy so the query has candidates to test
+    Vector3 playerPosition = {xs[0], 1.7f, zs[0]};
+    int iterations = IterationsFor(count);
+
+    for (int s = -BENCH_WARMUP_SAMPLES; s < bench->samples; s++) {
+        if (s == 0) ResetEnemyQueryStats(&crowd.manager);
+        double start = NowNs();
+        for (int i = 0; i < iterations; i++) {
+            memset(enemies->columns[COMPONENT_COOLDOWN], 0, sizeof(float) * count);
+            CheckEnemyPlayerCollision(&crowd.manager, &crowd.store, playerPosition, PLAYER_COLLISION_RADIUS,
+                                      BENCH_DT);
+        }
+        if (s >= 0) sampleNs[s] = NowNs() - start;
+    }
+    SpatialHashStats queries = GetEnemyQueryStats(&crowd.manager);
+    RecordResult(bench, "CheckEnemyPlayerCollision", count, iterations, sampleNs, &queries);
+    UnloadCrowd(&crowd);
+}
+
+// Fills a store with discs thrown from random points in the arena in random directions
+static void FillFrisbees(Bench *bench, EntityStore *store, int count) {
+    uint32_t rng = SeedRandom(bench->seed);
+    InitEntityStore(store);
+    Player player = InitPlayer();
+    float reach = bench->world->halfSize - 5.0f;
+    for (int i = 0; i < count; i++) {
+        Camera camera = {0};
+        camera.position = (Vector3){((float)NextRandom(&rng) / 0x7fffffff * 2.0f - 1.0f) * reach, 1.7f,
+                                    ((float)NextRandom(&rng) / 0x7fffffff * 2.0f - 1.0f) * reach};
+        float angle = (float)NextRandom(&rng) / 0x7fffffff * 2.0f * PI;
+        camera.target = Vector3Add(camera.position, (Vector3){cosf(angle), 0.0f, sinf(angle)});
+        camera.up = (Vector3){0.0f, 1.0f, 0.0f};
+        ThrowFrisbee(store, &player, camera, (float)NextRandom(&rng) / 0x7fffffff, 0.0f);
+    }
+}
+
+static void BenchUpdateFrisbees(Bench *bench, int count, double *sampleNs) {
+    int discs = count < MAX_FRISBEES ? count : MAX_FRISBEES;
+    int iterations = IterationsFor(discs);
+
+    for (int s = -BENCH_WARMUP_SAMPLES; s < bench->samples; s++) {
+        // Discs that land keep being integrated (only the sim removes them), so the cost
+        // per disc stays the same for the whole sample
+        EntityStore store;
+        FillFrisbees(bench, &store, discs);
+        double start = NowNs();
+        for (int i = 0; i < iterations; i++) UpdateFrisbees(&store, bench->world, BENCH_DT);
+        if (s >= 0) sampleNs[s] = NowNs() - start;
+        UnloadEntityStore(&store);
+    }
+    RecordResult(bench, "UpdateFrisbees", discs, iterations, sampleNs, NULL);
+}
+
+static void BenchFrisbeeEnemyCollision(Bench *bench, int count, double *sampleNs) {
+    Crowd crowd;
+    MakeEnemies(bench, &crowd, count);
+    // Nobody dies, so every sample sees the same crowd
+    int *healths = GetCrowdEnemies(&crowd)->columns[COMPONENT_HEALTH];
+    for (int i = 0; i < count; i++) healths[i] = INT_MAX;
+
+    EntityStore discStore;
+    FillFrisbees(bench, &discStore, MAX_FRISBEES);
+    UpdateFrisbees(&discStore, bench->world, BENCH_DT);
+    const Archetype *discs = &discStore.archetypes[GetArchetype(&discStore, FRISBEE_COMPONENTS)];
+    FrisbeeSweep *sweeps = discs->columns[COMPONENT_SWEEP];
+    for (int i = 0; i < discs->count; i++) sweeps[i].hitTime = 1.0f;
+    FrisbeeHit hits[MAX_FRISBEES];
+    int iterations = IterationsFor(count);
+
+    for (int s = -BENCH_WARMUP_SAMPLES; s < bench->samples; s++) {
+        if (s == 0) ResetEnemyQueryStats(&crowd.manager);
+        double start = NowNs();
+        for (int i = 0; i < iterations; i++) {
+            CheckFrisbeeEnemyCollisions(&crowd.manager, &crowd.store, sweeps, discs->count, FRISBEE_RADIUS, hits);
+        }
+        if (s >= 0) sampleNs[s] = NowNs() - start;
+    }
+    // Entities here are the enemies in the field; the disc count is fixed at a full pool
+    SpatialHashStats queries = GetEnemyQueryStats(&crowd.manager);
+    RecordResult(bench, "CheckFrisbeeEnemyCollisions", count, iterations, sampleNs, &queries);
+
+    UnloadEntityStore(&discStore);
+    UnloadCrowd(&crowd);
+}
+
+static void PrintResults(const Bench *bench) {
+    printf("%-28s %9s %7s %14s %12s %14s %12s %11s %9s\n",
+           "benchmark", "entities", "iters", "ns/call", "stddev", "ns/entity", "Mentities/s", "cand/query", "max cand");
+    for (int i = 0; i < bench->resultCount; i++) {
+        const BenchResult *r = &bench->results[i];
+        printf("%-28s %9d %7d %14.1f %12.1f %14.3f %12.2f", r->name, r->entities, r->iterations,
+               r->meanNs, r->stddevNs, r->meanNs / r->entities, r->entities / r->meanNs * 1e3);
+        if (r->queries > 0) {
+            printf(" %11.2f %9d\n", r->candidatesPerQuery, r->maxCandidates);
+        } else {
+            printf(" %11s %9s\n", "-", "-");
+        }
+    }
+}
+
+static bool WriteJson(const Bench *bench, const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "{\n  \"seed\": %u,\n  \"samples\": %d,\n  \"threads\": %d,\n  \"results\": [\n", bench->seed,
+            bench->samples, bench->threads);
+    for (int i = 0; i < bench->resultCount; i++) {
+        const BenchResult *r = &bench->results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"entities\": %d, \"iterations\": %d, \"mean_ns\": %.3f, "
+                      "\"stddev_ns\": %.3f, \"variance_ns2\": %.3f, \"min_ns\": %.3f, \"median_ns\": %.3f, "
+                      "\"ns_per_entity\": %.5f, \"entities_per_sec\": %.1f",
+                r->name, r->entities, r->iterations, r->meanNs, r->stddevNs, r->stddevNs * r->stddevNs,
+                r->minNs, r->medianNs, r->meanNs / r->entities, r->entities / r->meanNs * 1e9);
+        if (r->queries > 0) {
+            fprintf(file, ", \"queries_per_call\": %d, \"candidates_per_query\": %.3f, \"max_candidates\": %d",
+                    r->queries, r->candidatesPerQuery, r->maxCandidates);
+        }
+        fprintf(file, "}%s\n", i + 1 < bench->resultCount ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+static bool WriteCsv(const Bench *bench, const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+    fprintf(file, "name,entities,iterations,samples,mean_ns,stddev_ns,variance_ns2,min_ns,median_ns,"
+                  "ns_per_entity,entities_per_sec,queries_per_call,candidates_per_query,max_candidates\n");
+    for (int i = 0; i < bench->resultCount; i++) {
+        const BenchResult *r = &bench->results[i];
+        fprintf(file, "%s,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.5f,%.1f,", r->name, r->entities, r->iterations,
+                r->samples, r->meanNs, r->stddevNs, r->stddevNs * r->stddevNs, r->minNs, r->medianNs,
+                r->meanNs / r->entities, r->entities / r->meanNs * 1e9);
+        // The query columns stay empty for benchmarks that make none
+        if (r->queries > 0) {
+            fprintf(file, "%d,%.3f,%d\n", r->queries, r->candidatesPerQuery, r->maxCandidates);
+        } else {
+            fprintf(file, ",,\n");
+        }
+    }
+    return fclose(file) == 0;
+}
+
+int main(int argc, char **argv) {
+    Bench bench = {0};
+    bench.samples = BENCH_DEFAULT_SAMPLES;
+    bench.seed = BENCH_DEFAULT_SEED;
+    bench.threads = 1;
+    const char *jsonPath = NULL;
+    const char *csvPath = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            bench.samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            bench.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            bench.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--samples N] [--seed S] [--threads N] [--json FILE] [--csv FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (bench.samples < 1) bench.samples = 1;
+    if (bench.threads > 1) InitJobSystem(bench.threads - 1);
+    bench.threads = GetJobWorkerCount() + 1;
+
+    StaticWorld world = BuildArenaWorld();
+    bench.world = &world;
+    double *sampleNs = malloc(sizeof(double) * bench.samples);
+
+    for (int c = 0; c < BENCH_COUNT_COUNT; c++) {
+        int count = benchCounts[c];
+        BenchInitEnemyManager(&bench, count, sampleNs);
+        BenchUpdateEnemies(&bench, count, sampleNs);
+        BenchEnemyPlayerCollision(&bench, count, sampleNs);
+        BenchFrisbeeEnemyCollision(&bench, count, sampleNs);
+        BenchUpdateFrisbees(&bench, count, sampleNs);
+    }
+
+    PrintResults(&bench);
+    int status = 0;
+    if (jsonPath && !WriteJson(&bench, jsonPath)) {
+        fprintf(stderr, "failed to write %s\n", jsonPath);
+        status = 1;
+    }
+    if (csvPath && !WriteCsv(&bench, csvPath)) {
+        fprintf(stderr, "failed to write %s\n", csvPath);
+        status = 1;
+    }
+
+    free(sampleNs);
+    UnloadStaticWorld(&world);
+    ShutdownJobSystem();
+    return status;
+}
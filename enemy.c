@@ -1,249 +1,548 @@
 #include "enemy.h"
 #include "raymath.h"
-#include "rlgl.h"
+#include "jobs.h"
+#include "frisbee.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
-// Tree positions from map.c (20 trees in a 5x4 grid)
-static Vector3 GetTreePosition(int index) {
-    float x = (index % 5) * 15.0f - 30.0f;
-    float z = (index / 5) * 15.0f - 30.0f;
-    return (Vector3){x, 0.0f, z};
+// Vector width for the UpdateEnemies kernels. AVX covers 8 enemies per instruction,
+// SSE2 (always present on x86-64) covers 4, everything else falls back to scalar code.
+// Define FRISBEE_SIM_SCALAR to force the scalar path for A/B comparisons.
+#if defined(__AVX__) && !defined(FRISBEE_SIM_SCALAR)
+#include <immintrin.h>
+#define ENEMY_SIMD_WIDTH 8
+typedef __m256 VFloat;
+#define VLoad(p) _mm256_load_ps(p)
+#define VStore(p, v) _mm256_store_ps(p, v)
+#define VSet1(s) _mm256_set1_ps(s)
+#define VAdd(a, b) _mm256_add_ps(a, b)
+#define VSub(a, b) _mm256_sub_ps(a, b)
+#define VMin(a, b) _mm256_min_ps(a, b)
+#define VMax(a, b) _mm256_max_ps(a, b)
+#define VGreater(a, b) _mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define VSelect(mask, a, b) _mm256_blendv_ps(b, a, mask)
+#elif defined(__SSE2__) && !defined(FRISBEE_SIM_SCALAR)
+#include <emmintrin.h>
+#define ENEMY_SIMD_WIDTH 4
+typedef __m128 VFloat;
+#define VLoad(p) _mm_load_ps(p)
+#define VStore(p, v) _mm_store_ps(p, v)
+#define VSet1(s) _mm_set1_ps(s)
+#define VAdd(a, b) _mm_add_ps(a, b)
+#define VSub(a, b) _mm_sub_ps(a, b)
+#define VMin(a, b) _mm_min_ps(a, b)
+#define VMax(a, b) _mm_max_ps(a, b)
+#define VGreater(a, b) _mm_cmpgt_ps(a, b)
+#define VSelect(mask, a, b) _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b))
+#else
+#define ENEMY_SIMD_WIDTH 1
+#endif
+
+#define ENEMY_JOB_GRAIN 2048  // Enemies per parallel chunk; a multiple of every SIMD width
+#define FRISBEE_JOB_GRAIN 32  // Discs per parallel collision chunk
+#define ENEMY_WALL_MARGIN 2.0f
+#define WALK_PHASE_PERIOD 6.28f
+
+static void SetEnemyFloat(Archetype *enemies, ComponentType component, int row, float value) {
+    float *column = enemies->columns[component];
+    if (column) column[row] = value;
 }
 
-static bool IsPositionValid(Vector3 pos, Vector3 playerStart) {
-    // Check minimum distance from player start (15 units)
-    float distToPlayer = sqrtf((pos.x - playerStart.x) * (pos.x - playerStart.x) +
-                               (pos.z - playerStart.z) * (pos.z - playerStart.z));
-    if (distToPlayer < 15.0f) return false;
+// Creates the entity a dormant enemy describes, in its archetype, and links it into the
+// broadphase. Reserve room with ReserveEnemies first.
+static int RestoreEnemy(EnemyManager *manager, EntityStore *store, const DormantEnemy *enemy) {
+    int id = CreateEntity(store, enemy->archetype);
+    Archetype *enemies = &store->archetypes[enemy->archetype];
+    int i = store->locations[id].row;
+    int *healths = enemies->columns[COMPONENT_HEALTH];
+    healths[i] = enemy->health;
+    SetEnemyFloat(enemies, COMPONENT_POSITION_X, i, enemy->x);
+    SetEnemyFloat(enemies, COMPONENT_POSITION_Z, i, enemy->z);
+    SetEnemyFloat(enemies, COMPONENT_PREVIOUS_X, i, enemy->x);
+    SetEnemyFloat(enemies, COMPONENT_PREVIOUS_Z, i, enemy->z);
+    SetEnemyFloat(enemies, COMPONENT_COOLDOWN, i, enemy->attackCooldown);
+    SetEnemyFloat(enemies, COMPONENT_WALK_PHASE, i, enemy->walkPhase);
+
+    InsertSpatialHash(&manager->grid, id, enemy->x, enemy->z);
+    return id;
+}
+
+EnemyManager InitEnemyManager(EntityStore *store, const StaticWorld *world, int enemyCount, uint32_t *rng) {
+    EnemyManager manager = {0};
+    InitSpatialHash(&manager.grid);
+    manager.flow = InitFlowField(world, ENEMY_COLLISION_RADIUS);
+    manager.archetype = GetArchetype(store, ENEMY_COMPONENTS);
+    if (manager.archetype < 0) {
+        TraceLog(LOG_WARNING, "ENEMY: The store holds %d archetypes, none left for enemies", MAX_ARCHETYPES);
+        return manager;
+    }
+
+    Vector3 playerStart = {0.0f, 0.0f, 4.0f};  // Player starts at (0, 2, 4), use XZ
+    Rectangle arena = {-world->halfSize, -world->halfSize, 2.0f * world->halfSize, 2.0f * world->halfSize};
+    SpawnEnemies(&manager, store, world, arena, playerStart, enemyCount, rng);
+    return manager;
+}
+
+void UnloadEnemyManager(EnemyManager *manager) {
+    UnloadSpatialHash(&manager->grid);
+    UnloadFlowField(&manager->flow);
+    *manager = (EnemyManager){0};
+}
 
-    // Check wall margins (5 units from edges at +-50)
-    if (pos.x < -45.0f || pos.x > 45.0f || pos.z < -45.0f || pos.z > 45.0f) return false;
+void ReserveEnemies(EnemyManager *manager, EntityStore *store, int count) {
+    ReserveEntities(store, manager->archetype, count);
+    ReserveSpatialHash(&manager->grid, store->idCapacity);
+}
+
+int AddEnemy(EnemyManager *manager, EntityStore *store, Vector3 position, float walkPhase) {
+    DormantEnemy enemy = {position.x, position.z, ENEMY_MAX_HEALTH, 0.0f, walkPhase, manager->archetype};
+    return RestoreEnemy(manager, store, &enemy);
+}
+
+SpawnArea GetEnemySpawnArea(Rectangle area, Vector3 playerPosition) {
+    return (SpawnArea){area, ENEMY_SPAWN_WALL_MARGIN, {playerPosition.x, playerPosition.z}, ENEMY_SPAWN_DISTANCE,
+                       ENEMY_SPAWN_CLEARANCE, ENEMY_COLLISION_RADIUS, ENEMY_SPAWN_SPACING};
+}
 
-    // Check tree avoidance (4 unit radius from each tree)
-    for (int i = 0; i < 20; i++) {
-        Vector3 treePos = GetTreePosition(i);
-        float distToTree = sqrtf((pos.x - treePos.x) * (pos.x - treePos.x) +
-                                 (pos.z - treePos.z) * (pos.z - treePos.z));
-        if (distToTree < 4.0f) return false;
+int SpawnEnemies(EnemyManager *manager, EntityStore *store, const StaticWorld *world, Rectangle area,
+                 Vector3 playerPosition, int count, uint32_t *rng) {
+    if (count <= 0) return 0;
+    SpawnArea spawn = GetEnemySpawnArea(area, playerPosition);
+    Vector2 *points = malloc((size_t)count * sizeof(Vector2));
+    if (!points) {
+        TraceLog(LOG_WARNING, "SPAWN: Cannot allocate room to place %d enemies", count);
+        return 0;
+    }
+    int placed = PlaceSpawnPoints(world, &spawn, count, rng, points);
+    if (placed < count) {
+        TraceLog(LOG_WARNING, "SPAWN: Room for only %d of %d enemies in %.1fx%.1f at (%.1f, %.1f)", placed, count,
+                 area.width, area.height, area.x, area.y);
     }
 
-    return true;
+    ReserveEnemies(manager, store, placed);
+    for (int i = 0; i < placed; i++) {
+        float walkPhase = (float)(NextRandom(rng) % 100) / 100.0f * WALK_PHASE_PERIOD;
+        AddEnemy(manager, store, (Vector3){points[i].x, 0.0f, points[i].y}, walkPhase);
+    }
+    free(points);
+    return placed;
 }
 
-EnemyManager InitEnemyManager(int enemyCount) {
-    EnemyManager manager = {0};
-    manager.count = enemyCount;
-    manager.aliveCount = enemyCount;
+// Step 1: one flow field lookup per enemy. In the player's own cell there is no path left
+// to follow, so head straight for the player.
+static void FollowFlowField(const FlowField *field, float *xs, float *zs, int begin, int end,
+                            Vector3 playerPosition, float dt) {
+    for (int i = begin; i < end; i++) {
+        int cell = GetFlowCell(field, xs[i], zs[i]);
+        if (cell != field->goalCell) {
+            xs[i] += field->dirX[cell] * ENEMY_SPEED * dt;
+            zs[i] += field->dirZ[cell] * ENEMY_SPEED * dt;
+            continue;
+        }
 
-    Vector3 playerStart = {0.0f, 0.0f, 4.0f};  // Player starts at (0, 2, 4), use XZ
+        float dx = playerPosition.x - xs[i];
+        float dz = playerPosition.z - zs[i];
+        float dist = sqrtf(dx * dx + dz * dz);
+        if (dist > 0.1f) {
+            xs[i] += dx / dist * ENEMY_SPEED * dt;
+            zs[i] += dz / dist * ENEMY_SPEED * dt;
+        }
+    }
+}
 
-    for (int i = 0; i < enemyCount; i++) {
-        manager.enemies[i].health = ENEMY_MAX_HEALTH;
-        manager.enemies[i].alive = true;
-        manager.enemies[i].attackCooldown = 0.0f;
-        manager.enemies[i].walkPhase = (float)(rand() % 100) / 100.0f * 6.28f;
+// Step 2: clamp to map bounds
+static void ClampToBounds(float *xs, float *zs, int begin, int end, float bounds) {
+#if ENEMY_SIMD_WIDTH > 1
+    VFloat lo = VSet1(-bounds);
+    VFloat hi = VSet1(bounds);
+    for (int i = begin; i < end; i += ENEMY_SIMD_WIDTH) {
+        VStore(xs + i, VMin(VMax(VLoad(xs + i), lo), hi));
+        VStore(zs + i, VMin(VMax(VLoad(zs + i), lo), hi));
+    }
+#else
+    for (int i = begin; i < end; i++) {
+        if (xs[i] < -bounds) xs[i] = -bounds;
+        if (xs[i] > bounds) xs[i] = bounds;
+        if (zs[i] < -bounds) zs[i] = -bounds;
+        if (zs[i] > bounds) zs[i] = bounds;
+    }
+#endif
+}
+
+typedef struct {
+    const FlowField *flow;
+    float *xs;
+    float *zs;
+    float bounds;
+    Vector3 playerPosition;
+    float dt;
+} SteeringJob;
+
+// Both steps only touch enemy i's own slots, so any split into chunks gives the same result
+static void SteerRange(int begin, int end, void *context) {
+    SteeringJob *job = context;
+    FollowFlowField(job->flow, job->xs, job->zs, begin, end, job->playerPosition, job->dt);
+    ClampToBounds(job->xs, job->zs, begin, end, job->bounds);
+}
 
-        // Find valid spawn position
-        Vector3 spawnPos;
-        int attempts = 0;
-        do {
-            spawnPos.x = (float)(rand() % 80) - 40.0f;  // -40 to 40
-            spawnPos.y = 0.0f;
-            spawnPos.z = (float)(rand() % 80) - 40.0f;
-            attempts++;
-        } while (!IsPositionValid(spawnPos, playerStart) && attempts < 100);
+typedef struct {
+    const EnemyManager *manager;
+    float bounds;
+    Vector3 playerPosition;
+    float dt;
+} EnemyUpdate;
+
+// Movement system: remembers where each walker was, then steers it along the flow field
+static void SteerEnemies(Archetype *enemies, void *context) {
+    EnemyUpdate *update = context;
+    float *xs = enemies->columns[COMPONENT_POSITION_X];
+    float *zs = enemies->columns[COMPONENT_POSITION_Z];
+    memcpy(enemies->columns[COMPONENT_PREVIOUS_X], xs, enemies->count * sizeof(float));
+    memcpy(enemies->columns[COMPONENT_PREVIOUS_Z], zs, enemies->count * sizeof(float));
+
+    SteeringJob job = {&update->manager->flow, xs, zs, update->bounds, update->playerPosition, update->dt};
+    ParallelFor(enemies->count, ENEMY_JOB_GRAIN, SteerRange, &job);
+}
 
-        manager.enemies[i].position = spawnPos;
+typedef struct {
+    float *values;
+    float dt;
+} TimerJob;
+
+static void TickCooldownRange(int begin, int end, void *context) {
+    TimerJob *job = context;
+    float *cooldowns = job->values;
+#if ENEMY_SIMD_WIDTH > 1
+    VFloat zero = VSet1(0.0f);
+    VFloat vdt = VSet1(job->dt);
+    for (int i = begin; i < end; i += ENEMY_SIMD_WIDTH) {
+        VFloat cooldown = VLoad(cooldowns + i);
+        VStore(cooldowns + i, VSelect(VGreater(cooldown, zero), VSub(cooldown, vdt), cooldown));
+    }
+#else
+    for (int i = begin; i < end; i++) {
+        if (cooldowns[i] > 0.0f) cooldowns[i] -= job->dt;
     }
+#endif
+}
 
-    return manager;
+// Cooldown system: counts every attack timer down to zero
+static void TickCooldowns(Archetype *enemies, void *context) {
+    EnemyUpdate *update = context;
+    TimerJob job = {enemies->columns[COMPONENT_COOLDOWN], update->dt};
+    ParallelFor(enemies->count, ENEMY_JOB_GRAIN, TickCooldownRange, &job);
 }
 
-void UpdateEnemies(EnemyManager *manager, Vector3 playerPosition, float dt) {
-    for (int i = 0; i < manager->count; i++) {
-        Enemy *enemy = &manager->enemies[i];
-        if (!enemy->alive) continue;
+static void AdvanceWalkRange(int begin, int end, void *context) {
+    TimerJob *job = context;
+    float *phases = job->values;
+#if ENEMY_SIMD_WIDTH > 1
+    VFloat phaseStep = VSet1(job->dt * 10.0f);
+    VFloat period = VSet1(WALK_PHASE_PERIOD);
+    for (int i = begin; i < end; i += ENEMY_SIMD_WIDTH) {
+        VFloat phase = VAdd(VLoad(phases + i), phaseStep);
+        VStore(phases + i, VSelect(VGreater(phase, period), VSub(phase, period), phase));
+    }
+#else
+    for (int i = begin; i < end; i++) {
+        phases[i] += job->dt * 10.0f;
+        if (phases[i] > WALK_PHASE_PERIOD) phases[i] -= WALK_PHASE_PERIOD;
+    }
+#endif
+}
 
-        // Calculate direction to player (XZ plane only)
-        Vector3 toPlayer = {
-            playerPosition.x - enemy->position.x,
-            0.0f,
-            playerPosition.z - enemy->position.z
-        };
+// Animation system: advances the walk cycle
+static void AdvanceWalkCycles(Archetype *enemies, void *context) {
+    EnemyUpdate *update = context;
+    TimerJob job = {enemies->columns[COMPONENT_WALK_PHASE], update->dt};
+    ParallelFor(enemies->count, ENEMY_JOB_GRAIN, AdvanceWalkRange, &job);
+}
 
-        float dist = sqrtf(toPlayer.x * toPlayer.x + toPlayer.z * toPlayer.z);
-        if (dist > 0.1f) {
-            // Normalize direction
-            toPlayer.x /= dist;
-            toPlayer.z /= dist;
+// Incremental broadphase update: only targets that crossed a cell get relinked
+static void SyncBroadphase(Archetype *targets, void *context) {
+    EnemyManager *manager = context;
+    const float *xs = targets->columns[COMPONENT_POSITION_X];
+    const float *zs = targets->columns[COMPONENT_POSITION_Z];
+    for (int i = 0; i < targets->count; i++) {
+        MoveSpatialHash(&manager->grid, targets->entities[i], xs[i], zs[i]);
+    }
+}
 
-            // Move toward player
-            enemy->position.x += toPlayer.x * ENEMY_SPEED * dt;
-            enemy->position.z += toPlayer.z * ENEMY_SPEED * dt;
-        }
+void UpdateEnemies(EnemyManager *manager, EntityStore *store, const StaticWorld *world, Vector3 playerPosition,
+                   float dt) {
+    // Routes around the trees are shared by every enemy and only change with the player's cell
+    UpdateFlowField(&manager->flow, world, playerPosition.x, playerPosition.z);
+
+    EnemyUpdate update = {manager, world->halfSize - ENEMY_WALL_MARGIN, playerPosition, dt};
+    ComponentMask walkers = COMPONENT_BIT(COMPONENT_STEERING) | COMPONENT_BIT(COMPONENT_POSITION_X) |
+                            COMPONENT_BIT(COMPONENT_POSITION_Z) | COMPONENT_BIT(COMPONENT_PREVIOUS_X) |
+                            COMPONENT_BIT(COMPONENT_PREVIOUS_Z);
+    RunSystem(store, walkers, SteerEnemies, &update);
+    RunSystem(store, COMPONENT_BIT(COMPONENT_COOLDOWN), TickCooldowns, &update);
+    RunSystem(store, COMPONENT_BIT(COMPONENT_WALK_PHASE), AdvanceWalkCycles, &update);
+    RunSystem(store, TARGET_COMPONENTS, SyncBroadphase, manager);
+}
 
-        // Simple tree avoidance: push away if within 2.5 units
-        for (int t = 0; t < 20; t++) {
-            Vector3 treePos = GetTreePosition(t);
-            float distToTree = sqrtf((enemy->position.x - treePos.x) * (enemy->position.x - treePos.x) +
-                                     (enemy->position.z - treePos.z) * (enemy->position.z - treePos.z));
-            if (distToTree < 2.5f && distToTree > 0.01f) {
-                // Push away from tree
-                float pushX = (enemy->position.x - treePos.x) / distToTree;
-                float pushZ = (enemy->position.z - treePos.z) / distToTree;
-                float pushStrength = (2.5f - distToTree) * 2.0f;
-                enemy->position.x += pushX * pushStrength * dt;
-                enemy->position.z += pushZ * pushStrength * dt;
-            }
+static bool IsInsideBounds(Rectangle bounds, float x, float z) {
+    return x >= bounds.x && x < bounds.x + bounds.width && z >= bounds.y && z < bounds.y + bounds.height;
+}
+
+typedef struct {
+    EnemyManager *manager;
+    EntityStore *store;
+    DormantEnemies *dormant;
+    Rectangle bounds;
+} SuspendSystem;
+
+static void SuspendOutside(Archetype *enemies, void *context) {
+    SuspendSystem *system = context;
+    DormantEnemies *dormant = system->dormant;
+    int archetype = (int)(enemies - system->store->archetypes);
+    const float *xs = enemies->columns[COMPONENT_POSITION_X];
+    const float *zs = enemies->columns[COMPONENT_POSITION_Z];
+    const int *healths = enemies->columns[COMPONENT_HEALTH];
+    const float *cooldowns = enemies->columns[COMPONENT_COOLDOWN];
+    const float *phases = enemies->columns[COMPONENT_WALK_PHASE];
+
+    // Back to front, so the enemy moved into a freed slot has already been checked
+    for (int i = enemies->count - 1; i >= 0; i--) {
+        if (IsInsideBounds(system->bounds, xs[i], zs[i])) continue;
+
+        if (dormant->count == dormant->capacity) {
+            dormant->capacity = dormant->capacity > 0 ? dormant->capacity * 2 : 64;
+            dormant->items = realloc(dormant->items, dormant->capacity * sizeof(DormantEnemy));
         }
+        dormant->items[dormant->count++] = (DormantEnemy){xs[i], zs[i], healths[i], cooldowns[i], phases[i],
+                                                          archetype};
+        int id = enemies->entities[i];
+        RemoveSpatialHash(&system->manager->grid, id);
+        DestroyEntity(system->store, id);
+    }
+}
 
-        // Clamp to map bounds
-        if (enemy->position.x < -48.0f) enemy->position.x = -48.0f;
-        if (enemy->position.x > 48.0f) enemy->position.x = 48.0f;
-        if (enemy->position.z < -48.0f) enemy->position.z = -48.0f;
-        if (enemy->position.z > 48.0f) enemy->position.z = 48.0f;
+void SuspendEnemies(EnemyManager *manager, EntityStore *store, DormantEnemies *dormant, Rectangle bounds) {
+    SuspendSystem system = {manager, store, dormant, bounds};
+    RunSystem(store, DORMANT_COMPONENTS, SuspendOutside, &system);
+}
 
-        // Decrement attack cooldown
-        if (enemy->attackCooldown > 0.0f) {
-            enemy->attackCooldown -= dt;
+void UpdateDormantEnemies(EnemyManager *manager, EntityStore *store, DormantEnemies *dormant, Rectangle bounds,
+                          Vector3 playerPosition, float dt) {
+    int waking = 0;
+    for (int i = 0; i < dormant->count; i++) {
+        DormantEnemy *enemy = &dormant->items[i];
+        float dx = playerPosition.x - enemy->x;
+        float dz = playerPosition.z - enemy->z;
+        float dist = sqrtf(dx * dx + dz * dz);
+        if (dist > 0.1f) {
+            enemy->x += dx / dist * ENEMY_SPEED * dt;
+            enemy->z += dz / dist * ENEMY_SPEED * dt;
         }
-
-        // Update walk animation phase
-        enemy->walkPhase += dt * 10.0f;
-        if (enemy->walkPhase > 6.28f) enemy->walkPhase -= 6.28f;
+        if (IsInsideBounds(bounds, enemy->x, enemy->z)) waking++;
+    }
+    if (waking == 0) return;
+
+    ReserveEnemies(manager, store, waking);
+    for (int i = dormant->count - 1; i >= 0; i--) {
+        DormantEnemy *enemy = &dormant->items[i];
+        if (!IsInsideBounds(bounds, enemy->x, enemy->z)) continue;
+        RestoreEnemy(manager, store, enemy);
+        *enemy = dormant->items[--dormant->count];
     }
 }
 
-int CheckFrisbeeEnemyCollision(EnemyManager *manager, Vector3 frisbeePos, float frisbeeRadius) {
-    for (int i = 0; i < manager->count; i++) {
-        Enemy *enemy = &manager->enemies[i];
-        if (!enemy->alive) continue;
+void UnloadDormantEnemies(DormantEnemies *dormant) {
+    free(dormant->items);
+    *dormant = (DormantEnemies){0};
+}
 
-        // Enemy center is at y+1.0 (middle of body)
-        Vector3 enemyCenter = {
-            enemy->position.x,
-            enemy->position.y + 1.0f,
-            enemy->position.z
-        };
+// Health of a target, by entity id
+static int *GetTargetHealth(const EntityStore *store, int id) {
+    EntityLocation location = store->locations[id];
+    int *healths = store->archetypes[location.archetype].columns[COMPONENT_HEALTH];
+    return &healths[location.row];
+}
 
-        float dist = Vector3Distance(frisbeePos, enemyCenter);
-        if (dist < frisbeeRadius + ENEMY_COLLISION_RADIUS) {
-            enemy->health--;
-            if (enemy->health <= 0) {
-                enemy->alive = false;
-                manager->aliveCount--;
-                return 2;  // Enemy killed
-            }
-            return 1;  // Enemy damaged
-        }
+typedef struct {
+    const EntityStore *store;
+    Vector3 start;
+    Vector3 delta;
+    float hitDistance;
+    float hitTime;
+    int hitId;
+} FrisbeeQuery;
+
+static bool VisitFrisbeeCandidate(int id, void *context) {
+    FrisbeeQuery *query = context;
+    EntityLocation location = query->store->locations[id];
+    const Archetype *targets = &query->store->archetypes[location.archetype];
+    int row = location.row;
+
+    // Enemy center is at y+1.0 (middle of body)
+    const float *xs = targets->columns[COMPONENT_POSITION_X];
+    const float *zs = targets->columns[COMPONENT_POSITION_Z];
+    Vector3 enemyCenter = {xs[row], 1.0f, zs[row]};
+
+    // Earliest t with |start + t*delta - center| = hitDistance
+    Vector3 m = Vector3Subtract(query->start, enemyCenter);
+    float c = Vector3DotProduct(m, m) - query->hitDistance * query->hitDistance;
+    float t;
+    if (c < 0.0f) {
+        t = 0.0f;  // Already overlapping at the start of the step
+    } else {
+        float a = Vector3DotProduct(query->delta, query->delta);
+        float b = Vector3DotProduct(m, query->delta);
+        float discriminant = b * b - a * c;
+        if (a <= 0.0f || b >= 0.0f || discriminant < 0.0f) return true;  // Static, moving away or missing
+        t = (-b - sqrtf(discriminant)) / a;
+    }
+
+    // Targets killed earlier this step wait for RemoveDeadEnemies; only a would-be hit pays
+    // for the health lookup
+    const int *healths = targets->columns[COMPONENT_HEALTH];
+    if (t < query->hitTime && healths[row] > 0) {
+        query->hitTime = t;
+        query->hitId = id;
     }
-    return 0;  // No hit
+    return true;
 }
 
-int CheckEnemyPlayerCollision(EnemyManager *manager, Vector3 playerPos, float playerRadius, float dt) {
-    (void)dt;  // Currently unused but kept for future use
-    int totalDamage = 0;
+// First target a disc's sweep touches, found without changing anything
+typedef struct {
+    int enemy;       // Entity id, ENTITY_NONE for no hit
+    float hitTime;
+    int candidates;  // For the spatial hash stats
+} FrisbeeProbe;
+
+typedef struct {
+    const EnemyManager *manager;
+    const EntityStore *store;
+    const FrisbeeSweep *sweeps;
+    float hitDistance;
+    FrisbeeProbe *probes;
+} FrisbeeProbeJob;
+
+static FrisbeeProbe ProbeFrisbee(const EnemyManager *manager, const EntityStore *store, const FrisbeeSweep *sweep,
+                                 float hitDistance) {
+    FrisbeeQuery query = {store, sweep->start, Vector3Subtract(sweep->end, sweep->start), hitDistance,
+                          sweep->hitTime, ENTITY_NONE};
+
+    // One broadphase query around the whole path
+    float midX = (sweep->start.x + sweep->end.x) / 2.0f;
+    float midZ = (sweep->start.z + sweep->end.z) / 2.0f;
+    float reach = fmaxf(fabsf(query.delta.x), fabsf(query.delta.z)) / 2.0f + hitDistance;
+    int candidates = VisitSpatialHash(&manager->grid, midX, midZ, reach, VisitFrisbeeCandidate, &query);
+    return (FrisbeeProbe){query.hitId, query.hitTime, candidates};
+}
 
-    for (int i = 0; i < manager->count; i++) {
-        Enemy *enemy = &manager->enemies[i];
-        if (!enemy->alive) continue;
+static void ProbeFrisbeeRange(int begin, int end, void *context) {
+    FrisbeeProbeJob *job = context;
+    for (int f = begin; f < end; f++) {
+        job->probes[f] = ProbeFrisbee(job->manager, job->store, &job->sweeps[f], job->hitDistance);
+    }
+}
 
-        // Distance check on XZ plane
-        float dist = sqrtf((playerPos.x - enemy->position.x) * (playerPos.x - enemy->position.x) +
-                           (playerPos.z - enemy->position.z) * (playerPos.z - enemy->position.z));
+int CheckFrisbeeEnemyCollisions(EnemyManager *manager, EntityStore *store, const FrisbeeSweep *sweeps,
+                                int sweepCount, float frisbeeRadius, FrisbeeHit *hits) {
+    float hitDistance = frisbeeRadius + ENEMY_COLLISION_RADIUS;
+    FrisbeeProbe probes[MAX_FRISBEES];
+    int hitCount = 0;
+
+    for (int first = 0; first < sweepCount; first += MAX_FRISBEES) {
+        int batch = sweepCount - first < MAX_FRISBEES ? sweepCount - first : MAX_FRISBEES;
+
+        // Probe every disc in parallel against the crowd as it stands
+        FrisbeeProbeJob job = {manager, store, sweeps + first, hitDistance, probes};
+        ParallelFor(batch, FRISBEE_JOB_GRAIN, ProbeFrisbeeRange, &job);
+
+        // Then resolve in disc order, so two discs reaching the same enemy on one frame hit it
+        // in turn and a disc arriving after the kill flies on. Kills only take candidates
+        // away, so a probe stays exact while the target it found lives; only a disc whose
+        // target an earlier one killed probes again. The result is the same for any thread count.
+        for (int b = 0; b < batch; b++) {
+            int f = first + b;
+            FrisbeeProbe probe = probes[b];
+            if (probe.enemy != ENTITY_NONE && *GetTargetHealth(store, probe.enemy) <= 0) {
+                probe = ProbeFrisbee(manager, store, &sweeps[f], hitDistance);
+            }
+            RecordSpatialHashQuery(&manager->grid, probe.candidates);
+            if (probe.enemy == ENTITY_NONE) continue;  // No hit
 
-        float attackRange = playerRadius + ENEMY_COLLISION_RADIUS;
-        if (dist < attackRange && enemy->attackCooldown <= 0.0f) {
-            totalDamage++;
-            enemy->attackCooldown = ENEMY_ATTACK_COOLDOWN;
+            int *health = GetTargetHealth(store, probe.enemy);
+            (*health)--;
+            int result = *health <= 0 ? 2 : 1;  // Killed or damaged
+            hits[hitCount++] = (FrisbeeHit){f, result, probe.hitTime};
         }
     }
+    return hitCount;
+}
 
-    return totalDamage;
-}
-
-void DrawEnemies(EnemyManager *manager, Vector3 playerPosition) {
-    for (int i = 0; i < manager->count; i++) {
-        Enemy *enemy = &manager->enemies[i];
-        if (!enemy->alive) continue;
-
-        Vector3 pos = enemy->position;
-
-        // Calculate angle to face player
-        float dx = playerPosition.x - pos.x;
-        float dz = playerPosition.z - pos.z;
-        float angle = atan2f(dx, dz) * RAD2DEG;
-
-        // Walking animation - leg swing
-        float legSwing = sinf(enemy->walkPhase) * 25.0f;
-
-        // Colors
-        Color skinColor = (Color){255, 200, 150, 255};
-        Color jerseyColor = RED;
-        Color shortsColor = DARKBLUE;
-        Color eyeColor = BLACK;
-
-        rlPushMatrix();
-        rlTranslatef(pos.x, pos.y, pos.z);
-        rlRotatef(angle, 0, 1, 0);
-
-        // Left leg with animation
-        rlPushMatrix();
-        rlTranslatef(-0.15f, 0.7f, 0.0f);
-        rlRotatef(legSwing, 1, 0, 0);
-        rlTranslatef(0.0f, -0.35f, 0.0f);
-        DrawCube((Vector3){0, -0.15f, 0}, 0.15f, 0.4f, 0.15f, skinColor);  // Lower leg
-        DrawCube((Vector3){0, 0.15f, 0}, 0.2f, 0.3f, 0.2f, shortsColor);   // Upper leg
-        rlPopMatrix();
-
-        // Right leg with opposite animation
-        rlPushMatrix();
-        rlTranslatef(0.15f, 0.7f, 0.0f);
-        rlRotatef(-legSwing, 1, 0, 0);
-        rlTranslatef(0.0f, -0.35f, 0.0f);
-        DrawCube((Vector3){0, -0.15f, 0}, 0.15f, 0.4f, 0.15f, skinColor);  // Lower leg
-        DrawCube((Vector3){0, 0.15f, 0}, 0.2f, 0.3f, 0.2f, shortsColor);   // Upper leg
-        rlPopMatrix();
-
-        // Torso/Jersey
-        DrawCube((Vector3){0, 1.05f, 0}, 0.5f, 0.7f, 0.25f, jerseyColor);
-
-        // Left arm with swing
-        rlPushMatrix();
-        rlTranslatef(-0.35f, 1.1f, 0.0f);
-        rlRotatef(-legSwing * 0.5f, 1, 0, 0);
-        DrawCube((Vector3){0, 0, 0}, 0.15f, 0.35f, 0.15f, jerseyColor);    // Sleeve
-        DrawCube((Vector3){0, -0.3f, 0}, 0.12f, 0.3f, 0.12f, skinColor);   // Forearm
-        rlPopMatrix();
-
-        // Right arm with opposite swing
-        rlPushMatrix();
-        rlTranslatef(0.35f, 1.1f, 0.0f);
-        rlRotatef(legSwing * 0.5f, 1, 0, 0);
-        DrawCube((Vector3){0, 0, 0}, 0.15f, 0.35f, 0.15f, jerseyColor);    // Sleeve
-        DrawCube((Vector3){0, -0.3f, 0}, 0.12f, 0.3f, 0.12f, skinColor);   // Forearm
-        rlPopMatrix();
-
-        // Head
-        DrawCube((Vector3){0, 1.575f, 0}, 0.35f, 0.35f, 0.35f, skinColor);
-
-        // Eyes (facing forward in local space)
-        DrawCube((Vector3){-0.08f, 1.6f, 0.15f}, 0.06f, 0.06f, 0.06f, eyeColor);
-        DrawCube((Vector3){0.08f, 1.6f, 0.15f}, 0.06f, 0.06f, 0.06f, eyeColor);
-
-        rlPopMatrix();
-
-        // Health bar above head (drawn in world space, not rotated)
-        if (enemy->health < ENEMY_MAX_HEALTH) {
-            float barWidth = 0.6f;
-            float barHeight = 0.1f;
-            float healthPercent = (float)enemy->health / ENEMY_MAX_HEALTH;
-
-            DrawCube((Vector3){pos.x, pos.y + 2.0f, pos.z}, barWidth, barHeight, 0.05f, RED);
-            float fillWidth = barWidth * healthPercent;
-            float fillOffset = (barWidth - fillWidth) / 2.0f;
-            DrawCube((Vector3){pos.x - fillOffset, pos.y + 2.0f, pos.z + 0.01f}, fillWidth, barHeight, 0.05f, GREEN);
-        }
+typedef struct {
+    EnemyManager *manager;
+    EntityStore *store;
+    int removed;
+} HealthSystem;
+
+static void RemoveDeadRows(Archetype *targets, void *context) {
+    HealthSystem *system = context;
+    const int *healths = targets->columns[COMPONENT_HEALTH];
+    // Back to front, so the enemy moved into a freed slot has already been checked
+    for (int i = targets->count - 1; i >= 0; i--) {
+        if (healths[i] > 0) continue;
+        int id = targets->entities[i];
+        RemoveSpatialHash(&system->manager->grid, id);
+        DestroyEntity(system->store, id);
+        system->removed++;
     }
 }
+
+int RemoveDeadEnemies(EnemyManager *manager, EntityStore *store) {
+    HealthSystem system = {manager, store, 0};
+    RunSystem(store, TARGET_COMPONENTS, RemoveDeadRows, &system);
+    return system.removed;
+}
+
+typedef struct {
+    const EntityStore *store;
+    Vector3 position;
+    float attackRange;
+    int damage;
+} PlayerQuery;
+
+static bool VisitPlayerCandidate(int id, void *context) {
+    PlayerQuery *query = context;
+    EntityLocation location = query->store->locations[id];
+    const Archetype *targets = &query->store->archetypes[location.archetype];
+    float *cooldowns = targets->columns[COMPONENT_COOLDOWN];
+    if (!cooldowns) return true;  // Never attacks
+    int row = location.row;
+    const float *xs = targets->columns[COMPONENT_POSITION_X];
+    const float *zs = targets->columns[COMPONENT_POSITION_Z];
+
+    // Distance check on XZ plane
+    float dx = query->position.x - xs[row];
+    float dz = query->position.z - zs[row];
+    float dist = sqrtf(dx * dx + dz * dz);
+
+    if (dist < query->attackRange && cooldowns[row] <= 0.0f) {
+        query->damage++;
+        cooldowns[row] = ENEMY_ATTACK_COOLDOWN;
+    }
+    return true;
+}
+
+int CheckEnemyPlayerCollision(EnemyManager *manager, EntityStore *store, Vector3 playerPos, float playerRadius,
+                              float dt) {
+    (void)dt;  // Currently unused but kept for future use
+    PlayerQuery query = {store, playerPos, playerRadius + ENEMY_COLLISION_RADIUS, 0};
+    QuerySpatialHash(&manager->grid, playerPos.x, playerPos.z, query.attackRange, VisitPlayerCandidate, &query);
+    return query.damage;
+}
+
+SpatialHashStats GetEnemyQueryStats(const EnemyManager *manager) {
+    return manager->grid.stats;
+}
+
+void ResetEnemyQueryStats(EnemyManager *manager) {
+    ResetSpatialHashStats(&manager->grid);
+}
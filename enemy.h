@@ -2,33 +2,105 @@
 #define ENEMY_H
 
 #include "raylib.h"
+#include "spatial_hash.h"
+#include "world.h"
+#include "flowfield.h"
+#include "entity.h"
+#include "rng.h"
+#include "spawn.h"
 #include <stdbool.h>
 
-#define MAX_ENEMIES 15
 #define ENEMY_SPEED 3.0f
 #define ENEMY_COLLISION_RADIUS 0.8f
 #define ENEMY_MAX_HEALTH 2
 #define ENEMY_ATTACK_COOLDOWN 1.0f
+#define ENEMY_SPAWN_DISTANCE 15.0f    // Closest to the player an enemy appears
+#define ENEMY_SPAWN_WALL_MARGIN 5.0f
+#define ENEMY_SPAWN_CLEARANCE 4.0f    // From tree trunks
+#define ENEMY_SPAWN_SPACING (2.0f * ENEMY_COLLISION_RADIUS)  // Closest two enemies spawn, so none overlap
 
+// An enemy as spawned: it walks the flow field, attacks on contact and can be hit
+#define ENEMY_COMPONENTS (COMPONENT_BIT(COMPONENT_POSITION_X) | COMPONENT_BIT(COMPONENT_POSITION_Z) | \
+                          COMPONENT_BIT(COMPONENT_PREVIOUS_X) | COMPONENT_BIT(COMPONENT_PREVIOUS_Z) | \
+                          COMPONENT_BIT(COMPONENT_HEALTH) | COMPONENT_BIT(COMPONENT_COOLDOWN) | \
+                          COMPONENT_BIT(COMPONENT_WALK_PHASE) | COMPONENT_BIT(COMPONENT_STEERING))
+// What discs can hit and the broadphase tracks; these are the enemies a level counts
+#define TARGET_COMPONENTS (COMPONENT_BIT(COMPONENT_POSITION_X) | COMPONENT_BIT(COMPONENT_POSITION_Z) | \
+                           COMPONENT_BIT(COMPONENT_HEALTH))
+// What can step outside the simulated chunks and come back
+#define DORMANT_COMPONENTS (TARGET_COMPONENTS | COMPONENT_BIT(COMPONENT_COOLDOWN) | COMPONENT_BIT(COMPONENT_WALK_PHASE))
+
+// The systems that run enemies, over entities in an EntityStore, and the shared state they
+// need. Movement, attack cooldowns, the walk cycle, disc hits, contact damage and deaths
+// are each a pass over the archetypes with the components involved, so any archetype that
+// carries them takes part.
+typedef struct {
+    int archetype;     // Where spawned enemies go: the ENEMY_COMPONENTS archetype
+    SpatialHash grid;  // Broadphase over TARGET_COMPONENTS entity ids, kept in sync by UpdateEnemies
+    FlowField flow;    // Paths to the player around obstacles, rebuilt when the player changes cell
+} EnemyManager;
+
+// An enemy outside the simulated chunks. It keeps walking straight at the player, with no
+// pathing or collision, until it comes back in range and rejoins its archetype.
 typedef struct {
-    Vector3 position;
+    float x;
+    float z;
     int health;
-    bool alive;
     float attackCooldown;
     float walkPhase;
-} Enemy;
+    int archetype;
+} DormantEnemy;
 
 typedef struct {
-    Enemy enemies[MAX_ENEMIES];
+    DormantEnemy *items;
     int count;
-    int aliveCount;
-} EnemyManager;
+    int capacity;
+} DormantEnemies;
+
+typedef struct {
+    int frisbee;    // Index into the sweeps that were checked
+    int result;     // 1 = hit (damaged), 2 = hit (killed)
+    float hitTime;  // Fraction of the disc's path where it hit
+} FrisbeeHit;
 
-EnemyManager InitEnemyManager(int enemyCount);
-void UpdateEnemies(EnemyManager *manager, Vector3 playerPosition, float dt);
-// Returns: 0 = no hit, 1 = hit (damaged), 2 = hit (killed)
-int CheckFrisbeeEnemyCollision(EnemyManager *manager, Vector3 frisbeePos, float frisbeeRadius);
-int CheckEnemyPlayerCollision(EnemyManager *manager, Vector3 playerPos, float playerRadius, float dt);
-void DrawEnemies(EnemyManager *manager, Vector3 playerPosition);
+// Spawns enemies into `store` across the arena, as SpawnEnemies with the player at its start.
+// The manager's archetype is -1 when the store has no room for the enemy archetype; unload
+// it and fail whatever was being set up.
+EnemyManager InitEnemyManager(EntityStore *store, const StaticWorld *world, int enemyCount, uint32_t *rng);
+void UnloadEnemyManager(EnemyManager *manager);
+// Makes room for `count` more enemies in the store and the broadphase
+void ReserveEnemies(EnemyManager *manager, EntityStore *store, int count);
+// Creates an enemy at full health in the manager's archetype, after ReserveEnemies has made
+// room for it. Returns its entity id.
+int AddEnemy(EnemyManager *manager, EntityStore *store, Vector3 position, float walkPhase);
+// The rules SpawnEnemies places enemies by, in `area` with the player at playerPosition
+SpawnArea GetEnemySpawnArea(Rectangle area, Vector3 playerPosition);
+// Adds up to `count` enemies spread evenly over `area` (see PlaceSpawnPoints), kept away
+// from the player, the walls and the trees, and at least ENEMY_SPAWN_SPACING apart. Returns
+// how many it added; when the area has no room for the rest they are left out, with a warning.
+int SpawnEnemies(EnemyManager *manager, EntityStore *store, const StaticWorld *world, Rectangle area,
+                 Vector3 playerPosition, int count, uint32_t *rng);
+// Runs the movement, cooldown and walk cycle systems, then syncs the broadphase
+void UpdateEnemies(EnemyManager *manager, EntityStore *store, const StaticWorld *world, Vector3 playerPosition,
+                   float dt);
+// Moves DORMANT_COMPONENTS entities outside `bounds` to the dormant list
+void SuspendEnemies(EnemyManager *manager, EntityStore *store, DormantEnemies *dormant, Rectangle bounds);
+// Walks dormant enemies toward the player, then wakes those inside `bounds`
+void UpdateDormantEnemies(EnemyManager *manager, EntityStore *store, DormantEnemies *dormant, Rectangle bounds,
+                          Vector3 playerPosition, float dt);
+void UnloadDormantEnemies(DormantEnemies *dormant);
+// Sweeps each disc along its path and damages the first live target it touches before the
+// disc's own hitTime. Writes one FrisbeeHit per disc that hit and returns how many there
+// were. Targets brought to 0 health stay in the store until RemoveDeadEnemies.
+int CheckFrisbeeEnemyCollisions(EnemyManager *manager, EntityStore *store, const FrisbeeSweep *sweeps,
+                                int sweepCount, float frisbeeRadius, FrisbeeHit *hits);
+// Health system: destroys every target at 0 health or below and returns how many
+int RemoveDeadEnemies(EnemyManager *manager, EntityStore *store);
+// Contact damage from targets whose attack is off cooldown, restarting their cooldowns
+int CheckEnemyPlayerCollision(EnemyManager *manager, EntityStore *store, Vector3 playerPos, float playerRadius,
+                              float dt);
+// Candidates tested per collision query, to confirm query cost stays flat as counts grow
+SpatialHashStats GetEnemyQueryStats(const EnemyManager *manager);
+void ResetEnemyQueryStats(EnemyManager *manager);
 
 #endif
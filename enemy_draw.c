@@ -0,0 +1,236 @@
+#include "enemy_draw.h"
+#include "mesh_builder.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <math.h>
+
+// The walk phase rides in the bottom row of the instance matrix (m3), which is
+// always zero for affine transforms. The shader reads it back and clears it.
+static const char *ENEMY_VERTEX_SHADER =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec4 vertexColor;\n"
+    "in vec2 vertexTexCoord2;\n"  // x = limb swing factor, y = limb pivot height
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "out vec4 fragColor;\n"
+    "void main() {\n"
+    "    mat4 model = instanceTransform;\n"
+    "    float phase = model[0][3];\n"
+    "    model[0][3] = 0.0;\n"
+    "    float angle = radians(25.0) * sin(phase) * vertexTexCoord2.x;\n"
+    "    float c = cos(angle);\n"
+    "    float s = sin(angle);\n"
+    "    vec3 p = vertexPosition;\n"
+    "    float y = p.y - vertexTexCoord2.y;\n"
+    "    p.yz = vec2(vertexTexCoord2.y + y*c - p.z*s, y*s + p.z*c);\n"
+    "    fragColor = vertexColor;\n"
+    "    gl_Position = mvp*model*vec4(p, 1.0);\n"
+    "}\n";
+
+static const char *ENEMY_FRAGMENT_SHADER =
+    "#version 330\n"
+    "in vec4 fragColor;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    finalColor = fragColor*colDiffuse;\n"
+    "}\n";
+
+typedef struct {
+    Vector3 center;
+    Vector3 size;
+    Color color;
+    float swing;   // Multiplier on the walk cycle angle, 0 for rigid parts
+    float pivotY;  // Height of the hip or shoulder the limb rotates about
+} BodyPart;
+
+#define DEFAULT_SIMPLE_LOD_DISTANCE 35.0f
+#define DEFAULT_BOX_LOD_DISTANCE 60.0f
+
+// Bounding sphere around body and health bar, relative to the enemy's feet
+#define ENEMY_CULL_CENTER_Y 1.0f
+#define ENEMY_CULL_RADIUS 1.1f
+
+#define SKIN_COLOR (Color){255, 200, 150, 255}
+#define JERSEY_COLOR RED
+#define SHORTS_COLOR DARKBLUE
+#define EYE_COLOR BLACK
+
+// Rest pose of the full body parts in enemy space (facing +Z)
+static const BodyPart FULL_BODY_PARTS[] = {
+    // Left leg
+    {{-0.15f, 0.2f, 0.0f}, {0.15f, 0.4f, 0.15f}, SKIN_COLOR, 1.0f, 0.7f},    // Lower leg
+    {{-0.15f, 0.5f, 0.0f}, {0.2f, 0.3f, 0.2f}, SHORTS_COLOR, 1.0f, 0.7f},    // Upper leg
+    // Right leg, opposite swing
+    {{0.15f, 0.2f, 0.0f}, {0.15f, 0.4f, 0.15f}, SKIN_COLOR, -1.0f, 0.7f},
+    {{0.15f, 0.5f, 0.0f}, {0.2f, 0.3f, 0.2f}, SHORTS_COLOR, -1.0f, 0.7f},
+    // Torso/Jersey
+    {{0.0f, 1.05f, 0.0f}, {0.5f, 0.7f, 0.25f}, JERSEY_COLOR, 0.0f, 0.0f},
+    // Left arm, half swing against the left leg
+    {{-0.35f, 1.1f, 0.0f}, {0.15f, 0.35f, 0.15f}, JERSEY_COLOR, -0.5f, 1.1f},  // Sleeve
+    {{-0.35f, 0.8f, 0.0f}, {0.12f, 0.3f, 0.12f}, SKIN_COLOR, -0.5f, 1.1f},     // Forearm
+    // Right arm
+    {{0.35f, 1.1f, 0.0f}, {0.15f, 0.35f, 0.15f}, JERSEY_COLOR, 0.5f, 1.1f},
+    {{0.35f, 0.8f, 0.0f}, {0.12f, 0.3f, 0.12f}, SKIN_COLOR, 0.5f, 1.1f},
+    // Head
+    {{0.0f, 1.575f, 0.0f}, {0.35f, 0.35f, 0.35f}, SKIN_COLOR, 0.0f, 0.0f},
+    // Eyes
+    {{-0.08f, 1.6f, 0.15f}, {0.06f, 0.06f, 0.06f}, EYE_COLOR, 0.0f, 0.0f},
+    {{0.08f, 1.6f, 0.15f}, {0.06f, 0.06f, 0.06f}, EYE_COLOR, 0.0f, 0.0f}
+};
+
+// Same silhouette with the limbs folded into the boxes they hang from
+static const BodyPart SIMPLE_BODY_PARTS[] = {
+    {{0.0f, 0.325f, 0.0f}, {0.5f, 0.65f, 0.2f}, SHORTS_COLOR, 0.0f, 0.0f},    // Legs
+    {{0.0f, 1.025f, 0.0f}, {0.85f, 0.75f, 0.25f}, JERSEY_COLOR, 0.0f, 0.0f},  // Torso and arms
+    {{0.0f, 1.575f, 0.0f}, {0.35f, 0.35f, 0.35f}, SKIN_COLOR, 0.0f, 0.0f}     // Head
+};
+
+static const BodyPart BOX_BODY_PARTS[] = {
+    {{0.0f, 0.875f, 0.0f}, {0.5f, 1.75f, 0.3f}, JERSEY_COLOR, 0.0f, 0.0f}
+};
+
+static Mesh BuildBodyMesh(const BodyPart *parts, int count) {
+    MeshBuilder builder = {0};
+    for (int i = 0; i < count; i++) {
+        AppendMeshBox(&builder, parts[i].center, parts[i].size, parts[i].color, (Vector2){parts[i].swing, parts[i].pivotY});
+    }
+    return FinishMesh(&builder);
+}
+
+EnemyRenderer LoadEnemyRenderer(void) {
+    EnemyRenderer renderer = {0};
+    renderer.lod = (EnemyLodSettings){DEFAULT_SIMPLE_LOD_DISTANCE, DEFAULT_BOX_LOD_DISTANCE};
+
+    renderer.lodMeshes[ENEMY_LOD_FULL] = BuildBodyMesh(FULL_BODY_PARTS, sizeof(FULL_BODY_PARTS) / sizeof(BodyPart));
+    renderer.lodMeshes[ENEMY_LOD_SIMPLE] = BuildBodyMesh(SIMPLE_BODY_PARTS, sizeof(SIMPLE_BODY_PARTS) / sizeof(BodyPart));
+    renderer.lodMeshes[ENEMY_LOD_BOX] = BuildBodyMesh(BOX_BODY_PARTS, sizeof(BOX_BODY_PARTS) / sizeof(BodyPart));
+
+    MeshBuilder builder = {0};
+    AppendMeshBox(&builder, (Vector3){0}, (Vector3){1.0f, 1.0f, 1.0f}, WHITE, (Vector2){0});
+    renderer.barMesh = FinishMesh(&builder);
+
+    Shader shader = LoadShaderFromMemory(ENEMY_VERTEX_SHADER, ENEMY_FRAGMENT_SHADER);
+    if (shader.id == rlGetShaderIdDefault()) {
+        TraceLog(LOG_ERROR, "ENEMY: Instancing shader failed to compile, enemies will not render");
+    }
+    shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+
+    renderer.material = LoadMaterialDefault();
+    renderer.material.shader = shader;
+    return renderer;
+}
+
+void UnloadEnemyRenderer(EnemyRenderer *renderer) {
+    for (int lod = 0; lod < ENEMY_LOD_COUNT; lod++) {
+        UnloadMesh(renderer->lodMeshes[lod]);
+        free(renderer->lodTransforms[lod]);
+    }
+    UnloadMesh(renderer->barMesh);
+    UnloadMaterial(renderer->material);  // Also unloads the shader
+    free(renderer->barBackTransforms);
+    free(renderer->barFillTransforms);
+    *renderer = (EnemyRenderer){0};
+}
+
+static void ReserveInstances(EnemyRenderer *renderer, int count) {
+    if (count <= renderer->capacity) return;
+    int capacity = renderer->capacity > 0 ? renderer->capacity : 64;
+    while (capacity < count) capacity *= 2;
+    for (int lod = 0; lod < ENEMY_LOD_COUNT; lod++) {
+        renderer->lodTransforms[lod] = realloc(renderer->lodTransforms[lod], capacity * sizeof(Matrix));
+    }
+    renderer->barBackTransforms = realloc(renderer->barBackTransforms, capacity * sizeof(Matrix));
+    renderer->barFillTransforms = realloc(renderer->barFillTransforms, capacity * sizeof(Matrix));
+    renderer->capacity = capacity;
+}
+
+// Translation, scale and a Y rotation given as (sin, cos), avoiding atan2f and the trig behind MatrixRotateY
+static Matrix InstanceMatrix(Vector3 position, Vector3 scale, float sinYaw, float cosYaw) {
+    return (Matrix){
+        cosYaw * scale.x, 0.0f, sinYaw * scale.z, position.x,
+        0.0f, scale.y, 0.0f, position.y,
+        -sinYaw * scale.x, 0.0f, cosYaw * scale.z, position.z,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+}
+
+void DrawEnemies(EnemyRenderer *renderer, const EntityStore *store, Vector3 playerPosition, float alpha,
+                 const Frustum *frustum, CullStats *stats) {
+    ComponentMask mask = COMPONENT_BIT(COMPONENT_POSITION_X) | COMPONENT_BIT(COMPONENT_POSITION_Z) |
+                         COMPONENT_BIT(COMPONENT_PREVIOUS_X) | COMPONENT_BIT(COMPONENT_PREVIOUS_Z) |
+                         COMPONENT_BIT(COMPONENT_WALK_PHASE) | COMPONENT_BIT(COMPONENT_HEALTH);
+    ReserveInstances(renderer, CountEntities(store, mask));
+
+    float simpleDistSq = renderer->lod.simpleDistance * renderer->lod.simpleDistance;
+    float boxDistSq = renderer->lod.boxDistance * renderer->lod.boxDistance;
+    int *lodCounts = renderer->lodCounts;
+    for (int lod = 0; lod < ENEMY_LOD_COUNT; lod++) lodCounts[lod] = 0;
+
+    int barCount = 0;
+    for (int a = 0; a < store->archetypeCount; a++) {
+        const Archetype *enemies = &store->archetypes[a];
+        if (!HasComponents(enemies, mask)) continue;
+
+        const float *xs = enemies->columns[COMPONENT_POSITION_X];
+        const float *zs = enemies->columns[COMPONENT_POSITION_Z];
+        const float *previousXs = enemies->columns[COMPONENT_PREVIOUS_X];
+        const float *previousZs = enemies->columns[COMPONENT_PREVIOUS_Z];
+        const float *phases = enemies->columns[COMPONENT_WALK_PHASE];
+        const int *healths = enemies->columns[COMPONENT_HEALTH];
+        for (int i = 0; i < enemies->count; i++) {
+            Vector3 pos = {previousXs[i] + (xs[i] - previousXs[i]) * alpha, 0.0f,
+                           previousZs[i] + (zs[i] - previousZs[i]) * alpha};
+
+            stats->considered++;
+            Vector3 cullCenter = {pos.x, ENEMY_CULL_CENTER_Y, pos.z};
+            if (!IsSphereInFrustum(frustum, cullCenter, ENEMY_CULL_RADIUS)) continue;
+            stats->drawn++;
+
+            // Face the player: rotation taken straight from the normalized direction
+            float dx = playerPosition.x - pos.x;
+            float dz = playerPosition.z - pos.z;
+            float distSq = dx * dx + dz * dz;
+            float len = sqrtf(distSq);
+            float sinYaw = len > 0.0001f ? dx / len : 0.0f;
+            float cosYaw = len > 0.0001f ? dz / len : 1.0f;
+
+            EnemyLod lod = distSq < simpleDistSq ? ENEMY_LOD_FULL :
+                           distSq < boxDistSq ? ENEMY_LOD_SIMPLE : ENEMY_LOD_BOX;
+
+            Matrix body = InstanceMatrix(pos, (Vector3){1.0f, 1.0f, 1.0f}, sinYaw, cosYaw);
+            body.m3 = phases[i];
+            renderer->lodTransforms[lod][lodCounts[lod]++] = body;
+
+            // Health bar above head (world space, not rotated)
+            if (lod != ENEMY_LOD_BOX && healths[i] < ENEMY_MAX_HEALTH) {
+                float barWidth = 0.6f;
+                float barHeight = 0.1f;
+                float healthPercent = (float)healths[i] / ENEMY_MAX_HEALTH;
+                float fillWidth = barWidth * healthPercent;
+                float fillOffset = (barWidth - fillWidth) / 2.0f;
+
+                renderer->barBackTransforms[barCount] = InstanceMatrix((Vector3){pos.x, pos.y + 2.0f, pos.z},
+                    (Vector3){barWidth, barHeight, 0.05f}, 0.0f, 1.0f);
+                renderer->barFillTransforms[barCount] = InstanceMatrix((Vector3){pos.x - fillOffset, pos.y + 2.0f, pos.z + 0.01f},
+                    (Vector3){fillWidth, barHeight, 0.05f}, 0.0f, 1.0f);
+                barCount++;
+            }
+        }
+    }
+
+    renderer->material.maps[MATERIAL_MAP_DIFFUSE].color = WHITE;
+    for (int lod = 0; lod < ENEMY_LOD_COUNT; lod++) {
+        if (lodCounts[lod] == 0) continue;
+        DrawMeshInstanced(renderer->lodMeshes[lod], renderer->material, renderer->lodTransforms[lod], lodCounts[lod]);
+    }
+
+    if (barCount > 0) {
+        renderer->material.maps[MATERIAL_MAP_DIFFUSE].color = RED;
+        DrawMeshInstanced(renderer->barMesh, renderer->material, renderer->barBackTransforms, barCount);
+        renderer->material.maps[MATERIAL_MAP_DIFFUSE].color = GREEN;
+        DrawMeshInstanced(renderer->barMesh, renderer->material, renderer->barFillTransforms, barCount);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef ENEMY_DRAW_H
+#define ENEMY_DRAW_H
+
+#include "raylib.h"
+#include "enemy.h"
+#include "frustum.h"
+
+typedef enum {
+    ENEMY_LOD_FULL,    // Articulated body with swinging limbs and eyes
+    ENEMY_LOD_SIMPLE,  // Legs, torso and head as three rigid boxes
+    ENEMY_LOD_BOX,     // A single jersey-colored box, no health bar
+    ENEMY_LOD_COUNT
+} EnemyLod;
+
+// Distances from the player on the XZ plane where each coarser tier takes over
+typedef struct {
+    float simpleDistance;
+    float boxDistance;
+} EnemyLodSettings;
+
+// GPU-instanced enemy renderer. Each LOD tier is one mesh in its rest pose; the
+// vertex shader swings the full tier's limbs, so each frame uploads one matrix per
+// enemy (position, facing and walk phase) and a horde costs at most five draw calls.
+typedef struct {
+    Mesh lodMeshes[ENEMY_LOD_COUNT];
+    Mesh barMesh;           // Unit cube for health bars
+    Material material;      // Instancing shader, shared by all meshes
+    EnemyLodSettings lod;
+    int lodCounts[ENEMY_LOD_COUNT];  // Enemies drawn per tier last frame
+    Matrix *lodTransforms[ENEMY_LOD_COUNT];
+    Matrix *barBackTransforms;
+    Matrix *barFillTransforms;
+    int capacity;
+} EnemyRenderer;
+
+// Requires an OpenGL 3.3 context (also satisfied by Mesa's llvmpipe)
+EnemyRenderer LoadEnemyRenderer(void);
+void UnloadEnemyRenderer(EnemyRenderer *renderer);
+// Draws every walker in the store. Enemies whose bounding sphere is outside the frustum are
+// skipped before any instance data is written. Positions are blended from the previous
+// update to the current one by alpha (0 to 1). Enemies face playerPosition and pick their
+// LOD by distance to it, so pass the player blended by the same alpha.
+void DrawEnemies(EnemyRenderer *renderer, const EntityStore *store, Vector3 playerPosition, float alpha,
+                 const Frustum *frustum, CullStats *stats);
+
+#endif
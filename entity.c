@@ -0,0 +1,174 @@
+#include "entity.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define COLUMN_ALIGN 32
+#define COLUMN_PADDING 8  // Capacity is a multiple of this, so every column ends on COLUMN_ALIGN
+
+// Bytes per element of each component's column; 0 for tags
+static const size_t componentSizes[COMPONENT_COUNT] = {
+    [COMPONENT_POSITION_X] = sizeof(float),
+    [COMPONENT_POSITION_Z] = sizeof(float),
+    [COMPONENT_PREVIOUS_X] = sizeof(float),
+    [COMPONENT_PREVIOUS_Z] = sizeof(float),
+    [COMPONENT_HEALTH] = sizeof(int),
+    [COMPONENT_COOLDOWN] = sizeof(float),
+    [COMPONENT_WALK_PHASE] = sizeof(float),
+    [COMPONENT_STEERING] = 0,
+    [COMPONENT_BODY] = sizeof(Vector3),
+    [COMPONENT_VELOCITY] = sizeof(Vector3),
+    [COMPONENT_SPIN] = sizeof(float),
+    [COMPONENT_SWEEP] = sizeof(FrisbeeSweep),
+};
+
+static void *ResizeColumn(void *old, size_t size, int count, int capacity) {
+    // aligned_alloc needs a size that is a multiple of the alignment; capacity is always a
+    // multiple of 8 and every component is a multiple of 4 bytes, so that holds
+    void *column = aligned_alloc(COLUMN_ALIGN, (size_t)capacity * size);
+    memset(column, 0, (size_t)capacity * size);
+    if (old) {
+        memcpy(column, old, (size_t)count * size);
+        free(old);
+    }
+    return column;
+}
+
+static void GrowArchetype(Archetype *archetype, int capacity, bool withIds) {
+    if (capacity <= archetype->capacity) return;
+
+    int newCapacity = archetype->capacity > 0 ? archetype->capacity : 16;
+    while (newCapacity < capacity) newCapacity *= 2;
+    newCapacity = (newCapacity + COLUMN_PADDING - 1) / COLUMN_PADDING * COLUMN_PADDING;
+
+    for (int c = 0; c < COMPONENT_COUNT; c++) {
+        if (componentSizes[c] == 0 || !(archetype->mask & COMPONENT_BIT(c))) continue;
+        archetype->columns[c] = ResizeColumn(archetype->columns[c], componentSizes[c], archetype->count, newCapacity);
+    }
+    if (withIds) archetype->entities = realloc(archetype->entities, newCapacity * sizeof(int));
+    archetype->capacity = newCapacity;
+}
+
+static void GrowIds(EntityStore *store) {
+    int oldCapacity = store->idCapacity;
+    int newCapacity = oldCapacity > 0 ? oldCapacity * 2 : 64;
+    store->locations = realloc(store->locations, newCapacity * sizeof(EntityLocation));
+    store->freeIds = realloc(store->freeIds, newCapacity * sizeof(int));
+    // Hand out low ids first
+    for (int id = newCapacity - 1; id >= oldCapacity; id--) {
+        store->locations[id].archetype = -1;
+        store->freeIds[store->freeCount++] = id;
+    }
+    store->idCapacity = newCapacity;
+}
+
+void InitEntityStore(EntityStore *store) {
+    *store = (EntityStore){0};
+}
+
+void UnloadEntityStore(EntityStore *store) {
+    for (int a = 0; a < store->archetypeCount; a++) {
+        Archetype *archetype = &store->archetypes[a];
+        for (int c = 0; c < COMPONENT_COUNT; c++) free(archetype->columns[c]);
+        free(archetype->entities);
+    }
+    free(store->locations);
+    free(store->freeIds);
+    *store = (EntityStore){0};
+}
+
+int GetArchetype(EntityStore *store, ComponentMask mask) {
+    for (int a = 0; a < store->archetypeCount; a++) {
+        if (store->archetypes[a].mask == mask) return a;
+    }
+    if (store->archetypeCount == MAX_ARCHETYPES) return -1;
+
+    int a = store->archetypeCount++;
+    store->archetypes[a] = (Archetype){0};
+    store->archetypes[a].mask = mask;
+    return a;
+}
+
+void ReserveEntities(EntityStore *store, int archetype, int count) {
+    Archetype *rows = &store->archetypes[archetype];
+    GrowArchetype(rows, rows->count + count, true);
+    while (store->freeCount < count) GrowIds(store);
+}
+
+int CreateEntity(EntityStore *store, int archetype) {
+    Archetype *rows = &store->archetypes[archetype];
+    GrowArchetype(rows, rows->count + 1, true);
+    if (store->freeCount == 0) GrowIds(store);
+
+    int id = store->freeIds[--store->freeCount];
+    int row = rows->count++;
+    for (int c = 0; c < COMPONENT_COUNT; c++) {
+        if (rows->columns[c]) memset((char *)rows->columns[c] + row * componentSizes[c], 0, componentSizes[c]);
+    }
+    rows->entities[row] = id;
+    store->locations[id] = (EntityLocation){archetype, row};
+    return id;
+}
+
+void DestroyEntity(EntityStore *store, int id) {
+    Archetype *rows = &store->archetypes[store->locations[id].archetype];
+    int row = store->locations[id].row;
+    int last = --rows->count;
+    if (row != last) {
+        for (int c = 0; c < COMPONENT_COUNT; c++) {
+            if (!rows->columns[c]) continue;
+            char *column = rows->columns[c];
+            memcpy(column + row * componentSizes[c], column + last * componentSizes[c], componentSizes[c]);
+        }
+        int moved = rows->entities[last];
+        rows->entities[row] = moved;
+        store->locations[moved].row = row;
+    }
+    store->locations[id].archetype = -1;
+    store->freeIds[store->freeCount++] = id;
+}
+
+bool HasComponents(const Archetype *archetype, ComponentMask mask) {
+    return (archetype->mask & mask) == mask;
+}
+
+void RunSystem(EntityStore *store, ComponentMask mask, EntitySystem system, void *context) {
+    for (int a = 0; a < store->archetypeCount; a++) {
+        Archetype *archetype = &store->archetypes[a];
+        if (archetype->count > 0 && HasComponents(archetype, mask)) system(archetype, context);
+    }
+}
+
+int CountEntities(const EntityStore *store, ComponentMask mask) {
+    int count = 0;
+    for (int a = 0; a < store->archetypeCount; a++) {
+        if (HasComponents(&store->archetypes[a], mask)) count += store->archetypes[a].count;
+    }
+    return count;
+}
+
+void CopyEntityStore(EntityStore *copy, const EntityStore *store, ComponentMask components) {
+    for (int a = 0; a < store->archetypeCount; a++) {
+        const Archetype *from = &store->archetypes[a];
+        Archetype *to = &copy->archetypes[a];
+        ComponentMask mask = from->mask & components;
+        if (a >= copy->archetypeCount || to->mask != mask) {
+            // A slot the copy has not seen, or one it last filled from a different set
+            if (a < copy->archetypeCount) {
+                for (int c = 0; c < COMPONENT_COUNT; c++) free(to->columns[c]);
+            }
+            *to = (Archetype){0};
+            to->mask = mask;
+        }
+        to->count = 0;
+        GrowArchetype(to, from->count, false);
+        to->count = from->count;
+        for (int c = 0; c < COMPONENT_COUNT; c++) {
+            if (to->columns[c]) memcpy(to->columns[c], from->columns[c], from->count * componentSizes[c]);
+        }
+    }
+    for (int a = store->archetypeCount; a < copy->archetypeCount; a++) {
+        for (int c = 0; c < COMPONENT_COUNT; c++) free(copy->archetypes[a].columns[c]);
+        copy->archetypes[a] = (Archetype){0};
+    }
+    copy->archetypeCount = store->archetypeCount;
+}
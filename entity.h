@@ -0,0 +1,98 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MAX_ARCHETYPES 16
+#define ENTITY_NONE -1
+
+// The path a disc covered in one update, for continuous collision against enemies
+typedef struct {
+    Vector3 start;
+    Vector3 end;     // Where it would be without hitting anything
+    float hitTime;   // Fraction of start->end where it hit the ground, a tree or a wall; 1 if it flew freely
+    bool stopped;    // The disc hit something this step and should be removed
+} FrisbeeSweep;
+
+// Everything an entity can carry. Each component is one packed column per archetype,
+// holding the type given here; tags have no column and only mark the entity.
+typedef enum {
+    COMPONENT_POSITION_X,  // float, on the ground plane
+    COMPONENT_POSITION_Z,  // float
+    COMPONENT_PREVIOUS_X,  // float, position before the last update, for interpolated drawing
+    COMPONENT_PREVIOUS_Z,  // float
+    COMPONENT_HEALTH,      // int; the entity is removed once it reaches 0
+    COMPONENT_COOLDOWN,    // float, seconds until it may attack again
+    COMPONENT_WALK_PHASE,  // float, walk animation cycle
+    COMPONENT_STEERING,    // Tag: walks the flow field toward the player
+    COMPONENT_BODY,        // Vector3, free-flying position
+    COMPONENT_VELOCITY,    // Vector3
+    COMPONENT_SPIN,        // float, degrees (visual)
+    COMPONENT_SWEEP,       // FrisbeeSweep, written each update by the disc flight system
+    COMPONENT_COUNT
+} ComponentType;
+
+typedef uint32_t ComponentMask;
+#define COMPONENT_BIT(component) (1u << (component))
+
+// Every entity with one exact set of components. Rows are packed densely in [0, count);
+// a destroyed entity is replaced by the last row, so systems never test for dead slots.
+// Columns are 32-byte aligned and capacity is a multiple of 8, so vector kernels may read
+// and write the lanes between count and capacity.
+typedef struct {
+    ComponentMask mask;
+    int count;
+    int capacity;
+    int *entities;                   // Row -> entity id
+    void *columns[COMPONENT_COUNT];  // NULL for tags and components the archetype lacks
+} Archetype;
+
+// Where an entity's components live
+typedef struct {
+    int archetype;  // -1 while the id is free
+    int row;
+} EntityLocation;
+
+// Archetype-based entity storage. An entity is an id that names a row in one archetype;
+// systems pick archetypes by the components they need and run straight down the columns,
+// so any mix of actor types updates with packed loops. Ids come from a free list and stay
+// stable while the entity lives, whatever rows move around it.
+typedef struct {
+    Archetype archetypes[MAX_ARCHETYPES];
+    int archetypeCount;
+    EntityLocation *locations;  // Per id, together so a lookup by id is one load
+    int *freeIds;
+    int freeCount;
+    int idCapacity;             // Size of the per-id arrays; every id handed out is below it
+} EntityStore;
+
+// Runs over every row of one archetype
+typedef void (*EntitySystem)(Archetype *archetype, void *context);
+
+void InitEntityStore(EntityStore *store);
+void UnloadEntityStore(EntityStore *store);
+// Index of the archetype with exactly these components, created on first use.
+// Returns -1 when all MAX_ARCHETYPES are taken by other sets.
+int GetArchetype(EntityStore *store, ComponentMask mask);
+// Grows an archetype for `count` more rows, and the ids for `count` more entities, so a
+// batch of creates reallocates once and idCapacity already covers every id it hands out
+void ReserveEntities(EntityStore *store, int archetype, int count);
+// Appends a zeroed row to the archetype and returns the new entity's id. Columns may move,
+// so fetch them again afterwards; the row is locations[id].row.
+int CreateEntity(EntityStore *store, int archetype);
+// Frees the id; the archetype's last row moves into its slot
+void DestroyEntity(EntityStore *store, int id);
+bool HasComponents(const Archetype *archetype, ComponentMask mask);
+// Calls system once for each non-empty archetype with every component in `mask`, in
+// archetype order. The system may destroy rows of the archetype it was given.
+void RunSystem(EntityStore *store, ComponentMask mask, EntitySystem system, void *context);
+// Entities whose archetype has every component in `mask`
+int CountEntities(const EntityStore *store, ComponentMask mask);
+// Copies every row into `copy`, keeping only the columns in `components`, and growing its
+// columns as needed. Archetypes keep their indices. The copy has no ids, so use it only to
+// read, and free it with UnloadEntityStore.
+void CopyEntityStore(EntityStore *copy, const EntityStore *store, ComponentMask components);
+
+#endif
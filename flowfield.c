@@ -0,0 +1,174 @@
+#include "flowfield.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#define FLOW_STRAIGHT_COST 10
+#define FLOW_DIAGONAL_COST 14
+#define FLOW_BLOCKED_COST 1000  // Extra for stepping into a blocked cell; only used to walk back out
+#define FLOW_DIAGONAL 0.70710678f
+// Every open entry lies within one step of the distance being popped
+#define FLOW_BUCKET_COUNT (FLOW_BLOCKED_COST + FLOW_DIAGONAL_COST + 1)
+
+static const int neighborX[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+static const int neighborZ[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+
+static int ClampFlowCoord(float v, float origin, int dim) {
+    int cell = (int)floorf((v - origin) / FLOW_CELL_SIZE);
+    if (cell < 0) return 0;
+    if (cell >= dim) return dim - 1;
+    return cell;
+}
+
+int GetFlowCell(const FlowField *field, float x, float z) {
+    return ClampFlowCoord(z, field->originZ, field->dimZ) * field->dimX + ClampFlowCoord(x, field->originX, field->dimX);
+}
+
+FlowField InitFlowField(const StaticWorld *world, float clearance) {
+    FlowField field = {0};
+    field.window.minX = -1;
+    field.clearance = clearance;
+    field.goalCell = -1;
+
+    int windowChunks = 2 * WORLD_STREAM_RADIUS + 1;
+    if (windowChunks > world->chunkDim) windowChunks = world->chunkDim;
+    int side = (int)ceilf(windowChunks * WORLD_CHUNK_SIZE / FLOW_CELL_SIZE);
+    int cellCount = side * side;
+    field.blocked = malloc(cellCount * sizeof(bool));
+    field.distance = malloc(cellCount * sizeof(int));
+    field.dirX = malloc(cellCount * sizeof(float));
+    field.dirZ = malloc(cellCount * sizeof(float));
+    // Each cell is pushed at most once per neighbor that improves it
+    field.nodeCapacity = cellCount * 8 + 1;
+    field.nodes = malloc(field.nodeCapacity * sizeof(FlowNode));
+    field.bucketHead = malloc(FLOW_BUCKET_COUNT * sizeof(int));
+    return field;
+}
+
+// Re-rasterizes the blocked cells for a new window, reading only the world grid cells it
+// overlaps. A box listed in several of them is simply marked again.
+static void MoveFlowWindow(FlowField *field, const StaticWorld *world, WorldChunkRange window) {
+    Rectangle bounds = GetWorldChunkRangeBounds(world, window);
+    field->window = window;
+    field->originX = bounds.x;
+    field->originZ = bounds.y;
+    field->dimX = (int)ceilf(bounds.width / FLOW_CELL_SIZE);
+    field->dimZ = (int)ceilf(bounds.height / FLOW_CELL_SIZE);
+    float endX = field->originX + field->dimX * FLOW_CELL_SIZE;
+    float endZ = field->originZ + field->dimZ * FLOW_CELL_SIZE;
+    float clearance = field->clearance;
+    for (int c = 0; c < field->dimX * field->dimZ; c++) field->blocked[c] = false;
+
+    WorldCellRange first = GetWorldCellRange(world, field->originX - clearance, field->originZ - clearance, 0.0f);
+    WorldCellRange last = GetWorldCellRange(world, endX + clearance, endZ + clearance, 0.0f);
+    for (int gz = first.minZ; gz <= last.maxZ; gz++) {
+        for (int gx = first.minX; gx <= last.maxX; gx++) {
+            int cell = GetWorldCell(world, gx, gz);
+            for (int k = world->boxCellStart[cell]; k < world->boxCellStart[cell + 1]; k++) {
+                BoundingBox b = world->boxes[world->boxCellItems[k]].box;
+                if (b.min.y >= FLOW_OBSTACLE_HEIGHT) continue;
+                if (b.max.x + clearance < field->originX || b.min.x - clearance >= endX ||
+                    b.max.z + clearance < field->originZ || b.min.z - clearance >= endZ) {
+                    continue;  // Grown box stays outside the window
+                }
+
+                int minX = ClampFlowCoord(b.min.x - clearance, field->originX, field->dimX);
+                int maxX = ClampFlowCoord(b.max.x + clearance, field->originX, field->dimX);
+                int minZ = ClampFlowCoord(b.min.z - clearance, field->originZ, field->dimZ);
+                int maxZ = ClampFlowCoord(b.max.z + clearance, field->originZ, field->dimZ);
+                for (int cz = minZ; cz <= maxZ; cz++) {
+                    for (int cx = minX; cx <= maxX; cx++) field->blocked[cz * field->dimX + cx] = true;
+                }
+            }
+        }
+    }
+}
+
+void UnloadFlowField(FlowField *field) {
+    free(field->blocked);
+    free(field->distance);
+    free(field->dirX);
+    free(field->dirZ);
+    free(field->nodes);
+    free(field->bucketHead);
+    *field = (FlowField){0};
+}
+
+// Dijkstra outward from the goal. When a walker in cell v would best step to u, v records
+// the direction of u at the moment u improves it, so no second pass over the grid is needed.
+static void BuildFlowField(FlowField *field, int goalCell) {
+    int dimX = field->dimX;
+    int dimZ = field->dimZ;
+    int cellCount = dimX * dimZ;
+    for (int c = 0; c < cellCount; c++) {
+        field->distance[c] = INT_MAX;
+        field->dirX[c] = 0.0f;
+        field->dirZ[c] = 0.0f;
+    }
+
+    for (int b = 0; b < FLOW_BUCKET_COUNT; b++) field->bucketHead[b] = -1;
+
+    int nodeCount = 0;
+    int pending = 1;
+    field->distance[goalCell] = 0;
+    field->nodes[nodeCount] = (FlowNode){0, goalCell, -1};
+    field->bucketHead[0] = nodeCount++;
+
+    for (int current = 0; pending > 0; current++) {
+        int *head = &field->bucketHead[current % FLOW_BUCKET_COUNT];
+        while (*head >= 0) {
+            FlowNode node = field->nodes[*head];
+            *head = node.next;
+            pending--;
+
+            int u = node.cell;
+            if (node.distance > field->distance[u]) continue;  // Stale entry
+
+            int ux = u % dimX;
+            int uz = u / dimX;
+            int enterCost = field->blocked[u] ? FLOW_BLOCKED_COST : 0;
+
+            for (int n = 0; n < 8; n++) {
+                int vx = ux + neighborX[n];
+                int vz = uz + neighborZ[n];
+                if (vx < 0 || vx >= dimX || vz < 0 || vz >= dimZ) continue;
+                int v = vz * dimX + vx;
+
+                bool diagonal = n >= 4;
+                if (diagonal && !field->blocked[u] && !field->blocked[v] &&
+                    (field->blocked[uz * dimX + vx] || field->blocked[vz * dimX + ux])) {
+                    continue;  // Don't cut the corner of an obstacle between two open cells
+                }
+
+                int distance = node.distance + enterCost + (diagonal ? FLOW_DIAGONAL_COST : FLOW_STRAIGHT_COST);
+                if (distance >= field->distance[v]) continue;
+
+                float scale = diagonal ? FLOW_DIAGONAL : 1.0f;
+                field->distance[v] = distance;
+                field->dirX[v] = -neighborX[n] * scale;
+                field->dirZ[v] = -neighborZ[n] * scale;
+                int *bucket = &field->bucketHead[distance % FLOW_BUCKET_COUNT];
+                field->nodes[nodeCount] = (FlowNode){distance, v, *bucket};
+                *bucket = nodeCount++;
+                pending++;
+            }
+        }
+    }
+}
+
+bool UpdateFlowField(FlowField *field, const StaticWorld *world, float x, float z) {
+    WorldChunkRange window = GetWorldChunkRange(world, x, z, WORLD_STREAM_RADIUS);
+    if (memcmp(&window, &field->window, sizeof(WorldChunkRange)) != 0) {
+        MoveFlowWindow(field, world, window);
+        field->goalCell = -1;
+    }
+
+    int goalCell = GetFlowCell(field, x, z);
+    if (goalCell == field->goalCell) return false;
+
+    BuildFlowField(field, goalCell);
+    field->goalCell = goalCell;
+    field->builds++;
+    return true;
+}
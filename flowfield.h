@@ -0,0 +1,52 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "world.h"
+#include <stdbool.h>
+
+#define FLOW_CELL_SIZE 1.0f
+#define FLOW_OBSTACLE_HEIGHT 2.0f  // Boxes starting above this (foliage) do not block walkers
+
+typedef struct {
+    int distance;
+    int cell;
+    int next;  // Next node in the same bucket, -1 at the end
+} FlowNode;
+
+// Shared navigation toward one goal. Every cell stores the direction of the shortest path
+// to the goal cell, so any number of walkers steer with a single lookup each. Cells
+// blocked by an obstacle still get a direction, pointing back out to open ground.
+//
+// The field covers the streamed chunks around the goal rather than the whole world, so
+// its size and rebuild cost stay fixed however large the arena is. Positions outside the
+// window clamp to its edge.
+typedef struct {
+    WorldChunkRange window;  // Chunks covered; minX is -1 until the first update
+    float originX;        // World position of the window's minimum corner
+    float originZ;
+    int dimX;             // Cells along X and Z in the current window
+    int dimZ;
+    float clearance;      // Obstacles are grown by this much when rasterized
+    bool *blocked;
+    int *distance;        // Path cost to the goal cell (10 per straight step, 14 per diagonal)
+    float *dirX;          // Unit step toward the goal; zero in the goal cell itself
+    float *dirZ;
+    // Dijkstra open list as a ring of buckets, one per distance (Dial's algorithm): step
+    // costs are small integers, so popping is a scan forward instead of heap maintenance
+    int *bucketHead;
+    FlowNode *nodes;      // Bucket entries; stale ones are skipped when popped
+    int nodeCapacity;
+    int goalCell;         // -1 until the first build
+    int builds;           // Times the field was rebuilt, for profiling
+} FlowField;
+
+// Sizes the field for the largest window the world allows. Ground-level boxes, grown by
+// `clearance`, become blocked cells once the field is placed by UpdateFlowField.
+FlowField InitFlowField(const StaticWorld *world, float clearance);
+void UnloadFlowField(FlowField *field);
+// Moves the window when (x, z) enters another chunk, then re-runs the search only when
+// (x, z) lies in a different cell than the last goal. Returns true when the field was rebuilt.
+bool UpdateFlowField(FlowField *field, const StaticWorld *world, float x, float z);
+int GetFlowCell(const FlowField *field, float x, float z);
+
+#endif
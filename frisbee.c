@@ -3,151 +3,107 @@
 
 #define FRISBEE_GRAVITY 9.8f
 #define FRISBEE_DRAG 0.5f
-#define FRISBEE_RADIUS 0.15f
+#define FRISBEE_GROUND_HEIGHT 0.1f
 #define MIN_THROW_SPEED 10.0f
 #define MAX_THROW_SPEED 35.0f
 #define THROW_DURATION 0.3f
 
-Frisbee InitFrisbee(void) {
-    Frisbee frisbee = {0};
-    frisbee.position = (Vector3){0.0f, 1.0f, 0.0f};
-    frisbee.velocity = (Vector3){0.0f, 0.0f, 0.0f};
-    frisbee.rotation = 0.0f;
-    frisbee.inFlight = false;
-    return frisbee;
-}
+int ThrowFrisbee(EntityStore *store, Player *player, Camera camera, float chargePercent, float yawOffset) {
+    if (CountEntities(store, FLIGHT_COMPONENTS) >= MAX_FRISBEES) return ENTITY_NONE;
+    int archetype = GetArchetype(store, FRISBEE_COMPONENTS);
+    if (archetype < 0) return ENTITY_NONE;
 
-void ThrowFrisbee(Frisbee *frisbee, Player *player, Camera camera, float chargePercent) {
     Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    if (yawOffset != 0.0f) {
+        float c = cosf(yawOffset * DEG2RAD);
+        float s = sinf(yawOffset * DEG2RAD);
+        forward = (Vector3){forward.x * c - forward.z * s, forward.y, forward.x * s + forward.z * c};
+    }
 
     // Scale throw speed based on charge (0.0 to 1.0)
     float throwSpeed = MIN_THROW_SPEED + (MAX_THROW_SPEED - MIN_THROW_SPEED) * chargePercent;
 
-    frisbee->inFlight = true;
-    frisbee->position = camera.position;
-    frisbee->velocity = Vector3Scale(forward, throwSpeed);
-    frisbee->velocity.y += 2.0f * chargePercent;  // Upward arc scales with power
+    int id = CreateEntity(store, archetype);
+    Archetype *discs = &store->archetypes[archetype];
+    int i = store->locations[id].row;
+    Vector3 *bodies = discs->columns[COMPONENT_BODY];
+    Vector3 *velocities = discs->columns[COMPONENT_VELOCITY];
+    bodies[i] = camera.position;
+    velocities[i] = Vector3Scale(forward, throwSpeed);
+    velocities[i].y += 2.0f * chargePercent;  // Upward arc scales with power
 
     player->isThrowing = true;
     player->throwTimer = THROW_DURATION;
+    return id;
 }
 
-void ResetFrisbee(Frisbee *frisbee) {
-    frisbee->inFlight = false;
-    frisbee->velocity = (Vector3){0, 0, 0};
-    frisbee->rotation = 0.0f;
-}
-
-static bool CheckTreeCollision(Frisbee *frisbee) {
-    for (int i = 0; i < 20; i++) {
-        float x = (i % 5) * 15.0f - 30.0f;
-        float z = (i / 5) * 15.0f - 30.0f;
-        float height = 2.0f + (i % 3);
-
-        // Trunk collision (1x1xheight cube centered at x, height/2, z)
-        BoundingBox trunk = {
-            .min = {x - 0.5f, 0.0f, z - 0.5f},
-            .max = {x + 0.5f, height, z + 0.5f}
-        };
-        if (CheckCollisionBoxSphere(trunk, frisbee->position, FRISBEE_RADIUS)) {
-            return true;
+typedef struct {
+    const StaticWorld *world;
+    float dt;
+} FlightSystem;
+
+static void FlyBodies(Archetype *discs, void *context) {
+    FlightSystem *system = context;
+    float dt = system->dt;
+    float drag = 1.0f - FRISBEE_DRAG * dt;
+    Vector3 *bodies = discs->columns[COMPONENT_BODY];
+    Vector3 *velocities = discs->columns[COMPONENT_VELOCITY];
+    FrisbeeSweep *sweeps = discs->columns[COMPONENT_SWEEP];
+    float *spins = discs->columns[COMPONENT_SPIN];
+
+    for (int i = 0; i < discs->count; i++) {
+        Vector3 velocity = velocities[i];
+
+        // Apply gravity, then drag (air resistance)
+        velocity.y -= FRISBEE_GRAVITY * dt;
+        velocity = Vector3Scale(velocity, drag);
+        velocities[i] = velocity;
+
+        // Update position
+        FrisbeeSweep *sweep = &sweeps[i];
+        sweep->start = bodies[i];
+        sweep->end = Vector3Add(sweep->start, Vector3Scale(velocity, dt));
+        sweep->hitTime = 1.0f;
+        sweep->stopped = false;
+        bodies[i] = sweep->end;
+
+        // Spin rotation (visual)
+        if (spins) spins[i] += 720.0f * dt;
+
+        // Ground collision
+        float hitTime = 2.0f;
+        if (sweep->end.y <= FRISBEE_GROUND_HEIGHT) {
+            float drop = sweep->start.y - sweep->end.y;
+            hitTime = drop > 0.0f ? (sweep->start.y - FRISBEE_GROUND_HEIGHT) / drop : 0.0f;
+            if (hitTime < 0.0f) hitTime = 0.0f;
         }
 
-        // Foliage collision (3x3x3 cube at top of trunk)
-        BoundingBox foliage = {
-            .min = {x - 1.5f, height, z - 1.5f},
-            .max = {x + 1.5f, height + 3.0f, z + 1.5f}
-        };
-        if (CheckCollisionBoxSphere(foliage, frisbee->position, FRISBEE_RADIUS)) {
-            return true;
+        // Tree and wall collision
+        float worldHitTime = SweepWorldSphere(system->world, sweep->start, sweep->end, FRISBEE_RADIUS);
+        if (worldHitTime < hitTime) hitTime = worldHitTime;
+
+        if (hitTime <= 1.0f) {
+            sweep->hitTime = hitTime;
+            sweep->stopped = true;
+            bodies[i] = Vector3Lerp(sweep->start, sweep->end, hitTime);
         }
     }
-    return false;
 }
 
-static bool CheckWallCollision(Frisbee *frisbee) {
-    // North wall: z = -50, x = -50 to 50
-    BoundingBox northWall = {
-        .min = {-50.0f, 0.0f, -51.0f},
-        .max = {50.0f, 1.0f, -49.0f}
-    };
-    // South wall: z = 50
-    BoundingBox southWall = {
-        .min = {-50.0f, 0.0f, 49.0f},
-        .max = {50.0f, 1.0f, 51.0f}
-    };
-    // East wall: x = 50
-    BoundingBox eastWall = {
-        .min = {49.0f, 0.0f, -50.0f},
-        .max = {51.0f, 1.0f, 50.0f}
-    };
-    // West wall: x = -50
-    BoundingBox westWall = {
-        .min = {-51.0f, 0.0f, -50.0f},
-        .max = {-49.0f, 1.0f, 50.0f}
-    };
-
-    return CheckCollisionBoxSphere(northWall, frisbee->position, FRISBEE_RADIUS) ||
-           CheckCollisionBoxSphere(southWall, frisbee->position, FRISBEE_RADIUS) ||
-           CheckCollisionBoxSphere(eastWall, frisbee->position, FRISBEE_RADIUS) ||
-           CheckCollisionBoxSphere(westWall, frisbee->position, FRISBEE_RADIUS);
+void UpdateFrisbees(EntityStore *store, const StaticWorld *world, float dt) {
+    FlightSystem system = {world, dt};
+    RunSystem(store, FLIGHT_COMPONENTS, FlyBodies, &system);
 }
 
-void UpdateFrisbee(Frisbee *frisbee, float dt) {
-    if (!frisbee->inFlight) return;
-
-    // Apply gravity
-    frisbee->velocity.y -= FRISBEE_GRAVITY * dt;
-
-    // Apply drag (air resistance)
-    frisbee->velocity = Vector3Scale(frisbee->velocity, 1.0f - FRISBEE_DRAG * dt);
-
-    // Update position
-    frisbee->position = Vector3Add(frisbee->position, Vector3Scale(frisbee->velocity, dt));
-
-    // Spin rotation (visual)
-    frisbee->rotation += 720.0f * dt;
-
-    // Ground collision
-    if (frisbee->position.y <= 0.1f) {
-        ResetFrisbee(frisbee);
-        return;
-    }
-
-    // Tree collision
-    if (CheckTreeCollision(frisbee)) {
-        ResetFrisbee(frisbee);
-        return;
-    }
-
-    // Wall collision
-    if (CheckWallCollision(frisbee)) {
-        ResetFrisbee(frisbee);
-        return;
+static void RemoveStoppedBodies(Archetype *discs, void *context) {
+    EntityStore *store = context;
+    const FrisbeeSweep *sweeps = discs->columns[COMPONENT_SWEEP];
+    // Back to front, so the disc swapped into a freed slot has already been checked
+    for (int i = discs->count - 1; i >= 0; i--) {
+        if (sweeps[i].stopped) DestroyEntity(store, discs->entities[i]);
     }
 }
 
-void DrawFrisbee(Frisbee frisbee, Camera camera) {
-    Vector3 drawPos;
-
-    if (frisbee.inFlight) {
-        // In flight: draw at frisbee's world position
-        drawPos = frisbee.position;
-    } else {
-        // Not in flight: draw at end of arm
-        Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
-        Vector3 right = Vector3CrossProduct(forward, camera.up);
-
-        // Calculate arm position (same as DrawPlayerHand)
-        Vector3 armPos = camera.position;
-        armPos = Vector3Add(armPos, Vector3Scale(right, 0.3f));       // right
-        armPos = Vector3Add(armPos, Vector3Scale(camera.up, -0.25f)); // down
-        armPos = Vector3Add(armPos, Vector3Scale(forward, 0.5f));     // forward
-
-        // Frisbee at end of arm (extend further forward)
-        drawPos = Vector3Add(armPos, Vector3Scale(forward, 0.25f));
-    }
-
-    DrawCylinder(drawPos, 0.15f, 0.15f, 0.03f, 16, RED);
-    DrawCylinderWires(drawPos, 0.15f, 0.15f, 0.03f, 16, MAROON);
+void RemoveStoppedFrisbees(EntityStore *store) {
+    RunSystem(store, COMPONENT_BIT(COMPONENT_SWEEP), RemoveStoppedBodies, store);
 }
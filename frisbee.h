@@ -2,19 +2,45 @@
 #define FRISBEE_H
 
 #include "raylib.h"
+#include "entity.h"
 #include "player.h"
+#include "world.h"
+#include "frustum.h"
 
-typedef struct {
-    Vector3 position;
-    Vector3 velocity;
-    float rotation;
-    bool inFlight;
-} Frisbee;
+#define FRISBEE_RADIUS 0.15f
+#define MAX_FRISBEES 512            // Discs in flight at once
+#define SPREAD_FRISBEE_COUNT 3
+#define SPREAD_ANGLE 10.0f          // Degrees between neighboring discs in a spread throw
+#define RAPID_FIRE_INTERVAL 0.1f
+#define RAPID_FIRE_CHARGE 0.5f      // Throw power used by rapid fire
 
-Frisbee InitFrisbee(void);
-void DrawFrisbee(Frisbee frisbee, Camera camera);
-void ThrowFrisbee(Frisbee *frisbee, Player *player, Camera camera, float chargePercent);
-void UpdateFrisbee(Frisbee *frisbee, float dt);
-void ResetFrisbee(Frisbee *frisbee);
+typedef enum {
+    THROW_MODE_SINGLE,  // Charge and throw one disc; wait for it to land
+    THROW_MODE_MULTI,   // Charge and throw one disc, no waiting for the last one
+    THROW_MODE_SPREAD,  // Charge and throw a fan of discs
+    THROW_MODE_RAPID,   // Hold to fire a stream of half-power discs
+    THROW_MODE_COUNT
+} ThrowMode;
+
+// A disc in flight
+#define FRISBEE_COMPONENTS (COMPONENT_BIT(COMPONENT_BODY) | COMPONENT_BIT(COMPONENT_VELOCITY) | \
+                            COMPONENT_BIT(COMPONENT_SPIN) | COMPONENT_BIT(COMPONENT_SWEEP))
+// What the flight system moves: anything with a body, a velocity and a sweep
+#define FLIGHT_COMPONENTS (COMPONENT_BIT(COMPONENT_BODY) | COMPONENT_BIT(COMPONENT_VELOCITY) | \
+                           COMPONENT_BIT(COMPONENT_SWEEP))
+
+// Launches a disc from the camera along its view direction turned by yawOffset degrees.
+// Returns the new disc's entity id, or ENTITY_NONE when MAX_FRISBEES are already flying.
+int ThrowFrisbee(EntityStore *store, Player *player, Camera camera, float chargePercent, float yawOffset);
+// Flight system: advances every body with a velocity and sweeps each step against the
+// ground and the static world, so fast throws and long frames cannot tunnel. Bodies that
+// hit something only get their sweep marked; see RemoveStoppedFrisbees.
+void UpdateFrisbees(EntityStore *store, const StaticWorld *world, float dt);
+// Destroys every body whose last sweep stopped
+void RemoveStoppedFrisbees(EntityStore *store);
+
+// Draws each disc between its last sweep's start and its position, blended by alpha (0 to 1)
+void DrawFrisbees(const EntityStore *store, float alpha, const Frustum *frustum, CullStats *stats);
+void DrawHeldFrisbee(Camera camera);
 
 #endif
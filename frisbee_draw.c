@@ -0,0 +1,40 @@
+#include "frisbee.h"
+#include "raymath.h"
+
+static void DrawDisc(Vector3 position) {
+    DrawCylinder(position, FRISBEE_RADIUS, FRISBEE_RADIUS, 0.03f, 16, RED);
+    DrawCylinderWires(position, FRISBEE_RADIUS, FRISBEE_RADIUS, 0.03f, 16, MAROON);
+}
+
+void DrawFrisbees(const EntityStore *store, float alpha, const Frustum *frustum, CullStats *stats) {
+    ComponentMask mask = COMPONENT_BIT(COMPONENT_BODY) | COMPONENT_BIT(COMPONENT_SWEEP);
+    for (int a = 0; a < store->archetypeCount; a++) {
+        const Archetype *discs = &store->archetypes[a];
+        if (!HasComponents(discs, mask)) continue;
+
+        const Vector3 *bodies = discs->columns[COMPONENT_BODY];
+        const FrisbeeSweep *sweeps = discs->columns[COMPONENT_SWEEP];
+        for (int i = 0; i < discs->count; i++) {
+            // Every live disc was swept in the last update, so the sweep starts where it was before
+            Vector3 position = Vector3Lerp(sweeps[i].start, bodies[i], alpha);
+            stats->considered++;
+            if (!IsSphereInFrustum(frustum, position, FRISBEE_RADIUS)) continue;
+            stats->drawn++;
+            DrawDisc(position);
+        }
+    }
+}
+
+void DrawHeldFrisbee(Camera camera) {
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3CrossProduct(forward, camera.up);
+
+    // Calculate arm position (same as DrawPlayerHand)
+    Vector3 armPos = camera.position;
+    armPos = Vector3Add(armPos, Vector3Scale(right, 0.3f));       // right
+    armPos = Vector3Add(armPos, Vector3Scale(camera.up, -0.25f)); // down
+    armPos = Vector3Add(armPos, Vector3Scale(forward, 0.5f));     // forward
+
+    // Frisbee at end of arm (extend further forward)
+    DrawDisc(Vector3Add(armPos, Vector3Scale(forward, 0.25f)));
+}
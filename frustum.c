@@ -0,0 +1,33 @@
+#include "frustum.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <math.h>
+
+static Vector4 NormalizePlane(float a, float b, float c, float d) {
+    float len = sqrtf(a * a + b * b + c * c);
+    return (Vector4){a / len, b / len, c / len, d / len};
+}
+
+Frustum GetCameraFrustum(Camera camera, float aspect) {
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection = MatrixPerspective(camera.fovy * DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    Matrix m = MatrixMultiply(view, projection);  // projection * view
+
+    // Gribb-Hartmann: each plane is the last row of the clip matrix plus or minus another row
+    Frustum frustum;
+    frustum.planes[0] = NormalizePlane(m.m3 + m.m0, m.m7 + m.m4, m.m11 + m.m8, m.m15 + m.m12);
+    frustum.planes[1] = NormalizePlane(m.m3 - m.m0, m.m7 - m.m4, m.m11 - m.m8, m.m15 - m.m12);
+    frustum.planes[2] = NormalizePlane(m.m3 + m.m1, m.m7 + m.m5, m.m11 + m.m9, m.m15 + m.m13);
+    frustum.planes[3] = NormalizePlane(m.m3 - m.m1, m.m7 - m.m5, m.m11 - m.m9, m.m15 - m.m13);
+    frustum.planes[4] = NormalizePlane(m.m3 + m.m2, m.m7 + m.m6, m.m11 + m.m10, m.m15 + m.m14);
+    frustum.planes[5] = NormalizePlane(m.m3 - m.m2, m.m7 - m.m6, m.m11 - m.m10, m.m15 - m.m14);
+    return frustum;
+}
+
+bool IsSphereInFrustum(const Frustum *frustum, Vector3 center, float radius) {
+    for (int i = 0; i < 6; i++) {
+        Vector4 p = frustum->planes[i];
+        if (p.x * center.x + p.y * center.y + p.z * center.z + p.w < -radius) return false;
+    }
+    return true;
+}
@@ -0,0 +1,21 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Six normalized planes (x, y, z = inward normal, w = distance): left, right, bottom, top, near, far
+typedef struct {
+    Vector4 planes[6];
+} Frustum;
+
+typedef struct {
+    int considered;
+    int drawn;
+} CullStats;
+
+// Matches the projection BeginMode3D sets up for a perspective camera
+Frustum GetCameraFrustum(Camera camera, float aspect);
+bool IsSphereInFrustum(const Frustum *frustum, Vector3 center, float radius);
+
+#endif
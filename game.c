@@ -1,46 +1,75 @@
 #include "game.h"
-#include "camera.h"
-#include "map.h"
-#include "player.h"
-#include "enemy.h"
+#include "profiler.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-static const int LEVEL_ENEMY_COUNTS[] = {5, 10, 15};
-static const float MAX_CHARGE_TIME = 1.0f;  // 1 second to fully charge
+#define ENEMY_SOUND_DISTANCE 60.0f  // Enemy hits and deaths further away than this are not heard
 
+static void FindLevels(Game *game);
+static void LoadAudioCues(Game *game);
+static void StartLevel(Game *game);
 static void UpdateTitleScreen(Game *game);
 static void UpdateLevelSelect(Game *game);
+static void EndReplay(Game *game);
+static PlayerInput ReadPlayerInput(void);
 static void UpdatePlaying(Game *game);
+static void HandleSimEvents(Game *game, const SimEvents *events);
 static void UpdateGameOver(Game *game);
 static void UpdateVictory(Game *game);
-static void DrawTitleScreen(void);
+static void DrawTitleScreen(Game *game);
 static void DrawLevelSelect(Game *game);
 static void DrawHUD(Game *game);
-static void DrawGameOver(void);
+static void DrawGameOver(Game *game);
 static void DrawVictory(Game *game);
+static void DrawProfilerOverlay(Game *game);
+
+void InitGame(Game *game) {
+    memset(game, 0, sizeof(Game));
+    game->state = STATE_TITLE;
+    game->selectedLevel = 0;
+    game->enemiesRemaining = 0;
+    FindLevels(game);
+    InitSim(&game->sim, NULL, 0);
+    InitSimThread(&game->simThread);
+    game->snapshot = AcquireSimSnapshot(&game->simThread);
+    game->enemyRenderer = LoadEnemyRenderer();
+    InitUiLayer(&game->ui);
+    InitRenderScaler(&game->renderScale, RENDER_SCALE_MIN_DEFAULT, RENDER_SCALE_MAX_DEFAULT, 1.0f / 60.0f);
+    game->uiWidgets.screen = -1;
+    LoadArenaMap(&game->arena, &game->sim.world, game->sim.player.position);
+    // Audio decodes in the background; the title screen waits for it
+    InitAssetLoader(&game->assets);
+    QueueMusicAsset(&game->assets, "media/background.mp3", &game->backgroundMusic);
+    QueueSoundAsset(&game->assets, "media/frisbeeThrow.mp3", &game->throwSound);
+    QueueSoundAsset(&game->assets, "media/damage1.mp3", &game->damageSounds[0]);
+    QueueSoundAsset(&game->assets, "media/damage2.mp3", &game->damageSounds[1]);
+    QueueSoundAsset(&game->assets, "media/death1.mp3", &game->deathSounds[0]);
+    QueueSoundAsset(&game->assets, "media/death2.mp3", &game->deathSounds[1]);
+    QueueSoundAsset(&game->assets, "media/walkingGrass.mp3", &game->walkingSound);
+    StartAssetLoader(&game->assets);
+    InitAudioMixer(&game->audio);
+}
+
+void SetGameReplay(Game *game, ReplayMode mode, const char *path) {
+    game->replayMode = mode;
+    game->replayPath = path;
+}
 
-Game InitGame(void) {
-    Game game = {0};
-    game.state = STATE_TITLE;
-    game.selectedLevel = 1;
-    game.enemiesRemaining = 0;
-    game.camera = InitCamera();
-    game.frisbee = InitFrisbee();
-    game.player = InitPlayer();
-    // Load audio
-    game.backgroundMusic = LoadMusicStream("media/background.mp3");
-    game.throwSound = LoadSound("media/frisbeeThrow.mp3");
-    game.damageSounds[0] = LoadSound("media/damage1.mp3");
-    game.damageSounds[1] = LoadSound("media/damage2.mp3");
-    game.deathSounds[0] = LoadSound("media/death1.mp3");
-    game.deathSounds[1] = LoadSound("media/death2.mp3");
-    game.walkingSound = LoadSound("media/walkingGrass.mp3");
-    PlayMusicStream(game.backgroundMusic);
-    return game;
+void SetGameRenderScale(Game *game, float minScale, float maxScale, float frameBudget) {
+    InitRenderScaler(&game->renderScale, minScale, maxScale, frameBudget);
 }
 
-void UnloadGameAudio(Game *game) {
+void UnloadGame(Game *game) {
+    EndReplay(game);  // Stops the sim thread
+    UnloadArenaMap(&game->arena);  // Its builder thread reads the sim's world
+    UnloadSimThread(&game->simThread);
+    UnloadSim(&game->sim);
+    UnloadEnemyRenderer(&game->enemyRenderer);
+    UnloadUiLayer(&game->ui);
+    UnloadRenderScaler(&game->renderScale);
+    UnloadAudioMixer(&game->audio);
     UnloadMusicStream(game->backgroundMusic);
     UnloadSound(game->throwSound);
     UnloadSound(game->damageSounds[0]);
@@ -48,9 +77,27 @@ void UnloadGameAudio(Game *game) {
     UnloadSound(game->deathSounds[0]);
     UnloadSound(game->deathSounds[1]);
     UnloadSound(game->walkingSound);
+    UnloadAssetLoader(&game->assets);
 }
 
 void UpdateGame(Game *game) {
+    if (PollAssetLoader(&game->assets) > 0 && AreAssetsReady(&game->assets)) {
+        LoadAudioCues(game);
+        PlayMusicStream(game->backgroundMusic);
+    }
+
+    if (IsKeyPressed(KEY_F3)) game->showProfiler = !game->showProfiler;
+    if (IsKeyPressed(KEY_F4)) {
+        const char *path = "profile_trace.json";
+        if (!IsProfilerEnabled()) {
+            TraceLog(LOG_WARNING, "PROFILER: Built without FRISBEE_PROFILE, no trace to write");
+        } else if (WriteProfileTrace(path, PROFILE_TRACE_SECONDS)) {
+            TraceLog(LOG_INFO, "PROFILER: Wrote last %.0f seconds to %s", PROFILE_TRACE_SECONDS, path);
+        } else {
+            TraceLog(LOG_WARNING, "PROFILER: Failed to write %s", path);
+        }
+    }
+
     switch (game->state) {
         case STATE_TITLE:
             UpdateTitleScreen(game);
@@ -76,37 +123,69 @@ void DrawGame(Game *game) {
     switch (game->state) {
         case STATE_TITLE:
             ClearBackground(DARKBLUE);
-            DrawTitleScreen();
+            DrawTitleScreen(game);
             break;
         case STATE_LEVEL_SELECT:
             ClearBackground(DARKBLUE);
             DrawLevelSelect(game);
             break;
-        case STATE_PLAYING:
+        case STATE_PLAYING: {
+            // Only the scene is scaled, so only its frames steer the scale
+            UpdateRenderScaler(&game->renderScale, GetFrameTime());
+            BeginScaledRender(&game->renderScale);
             ClearBackground(SKYBLUE);
-            BeginMode3D(game->camera);
-            DrawMap();
-            DrawEnemies(&game->enemies, game->player.position);
-            float throwProgress = game->player.isThrowing ?
-                (1.0f - game->player.throwTimer / 0.3f) : 0.0f;
-            float chargeProgress = game->player.isCharging ?
-                (game->player.chargeTime / MAX_CHARGE_TIME) : 0.0f;
-            DrawPlayerHand(game->camera, throwProgress, chargeProgress);
-            DrawFrisbee(game->frisbee, game->camera);
+            game->renderStats = (RenderStats){0};
+            const SimSnapshot *snapshot = game->snapshot;
+            float alpha = GetSnapshotAlpha(snapshot);
+            Camera camera = GetSnapshotCamera(snapshot, alpha);
+            Frustum frustum = GetCameraFrustum(camera, (float)GetScreenWidth() / GetScreenHeight());
+
+            BeginMode3D(camera);
+            PROFILE_BEGIN("Draw map");
+            DrawMap(&game->arena, &frustum, &game->renderStats.arena);
+            PROFILE_END();
+            PROFILE_BEGIN("Draw enemies");
+            // The camera sits on the player, so its blended position is the player's as drawn
+            DrawEnemies(&game->enemyRenderer, &snapshot->actors, camera.position, alpha, &frustum,
+                        &game->renderStats.enemies);
+            PROFILE_END();
+            PROFILE_BEGIN("Draw hand");
+            float throwProgress = snapshot->player.isThrowing ?
+                (1.0f - snapshot->player.throwTimer / 0.3f) : 0.0f;
+            float chargeProgress = snapshot->player.isCharging ?
+                (snapshot->player.chargeTime / MAX_CHARGE_TIME) : 0.0f;
+            DrawPlayerHand(camera, throwProgress, chargeProgress);
+
+            // The held frisbee is always in view; only thrown ones can be culled. Only single
+            // mode waits for its disc to come down before there is another in hand.
+            if (snapshot->throwMode != THROW_MODE_SINGLE ||
+                CountEntities(&snapshot->actors, COMPONENT_BIT(COMPONENT_BODY)) == 0) {
+                game->renderStats.effects.considered++;
+                game->renderStats.effects.drawn++;
+                DrawHeldFrisbee(camera);
+            }
+            DrawFrisbees(&snapshot->actors, alpha, &frustum, &game->renderStats.effects);
+            PROFILE_END();
             EndMode3D();
+            PROFILE_BEGIN("Upscale");
+            EndScaledRender(&game->renderScale);
+            PROFILE_END();
 
             // Damage flash overlay
-            if (game->player.damageFlash > 0.0f) {
-                unsigned char alpha = (unsigned char)(game->player.damageFlash * 255.0f);
-                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), (Color){255, 0, 0, alpha});
+            if (snapshot->player.damageFlash > 0.0f) {
+                unsigned char flash = (unsigned char)(snapshot->player.damageFlash * 255.0f);
+                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), (Color){255, 0, 0, flash});
             }
 
+            PROFILE_BEGIN("Draw HUD");
             DrawFPS(10, 10);
             DrawHUD(game);
+            PROFILE_END();
             break;
+        }
         case STATE_GAME_OVER:
             ClearBackground(DARKGRAY);
-            DrawGameOver();
+            DrawGameOver(game);
             break;
         case STATE_VICTORY:
             ClearBackground((Color){0, 80, 0, 255});
@@ -114,199 +193,375 @@ void DrawGame(Game *game) {
             break;
     }
 
+    if (game->showProfiler) DrawProfilerOverlay(game);
+
+    // Includes waiting for vsync
+    PROFILE_BEGIN("Present");
     EndDrawing();
+    PROFILE_END();
+
+    if (!game->firstFrameDrawn) {
+        game->firstFrameDrawn = true;
+        TraceLog(LOG_INFO, "STARTUP: First frame after %.1f ms", GetTime() * 1000.0);
+    }
 }
 
 static void UpdateTitleScreen(Game *game) {
-    if (GetKeyPressed() != 0) {
+    if (game->replayMode == REPLAY_MODE_PLAYBACK && AreAssetsReady(&game->assets)) {
+        StartLevel(game);
+        return;
+    }
+    if (AreAssetsReady(&game->assets) && GetKeyPressed() != 0) {
         game->state = STATE_LEVEL_SELECT;
     }
 }
 
 static void UpdateLevelSelect(Game *game) {
+    if (game->levelCount == 0) return;
+
     if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_LEFT)) {
-        game->selectedLevel--;
-        if (game->selectedLevel < 1) game->selectedLevel = 3;
+        game->selectedLevel = (game->selectedLevel + game->levelCount - 1) % game->levelCount;
     }
     if (IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_RIGHT)) {
-        game->selectedLevel++;
-        if (game->selectedLevel > 3) game->selectedLevel = 1;
+        game->selectedLevel = (game->selectedLevel + 1) % game->levelCount;
     }
 
-    if (IsKeyPressed(KEY_ONE)) game->selectedLevel = 1;
-    if (IsKeyPressed(KEY_TWO)) game->selectedLevel = 2;
-    if (IsKeyPressed(KEY_THREE)) game->selectedLevel = 3;
+    for (int i = 0; i < game->levelCount; i++) {
+        if (IsKeyPressed(KEY_ONE + i)) game->selectedLevel = i;
+    }
 
     if (IsKeyPressed(KEY_ENTER)) {
-        int enemyCount = LEVEL_ENEMY_COUNTS[game->selectedLevel - 1];
-        game->enemiesRemaining = enemyCount;
-        game->camera = InitCamera();
-        game->frisbee = InitFrisbee();
-        game->player = InitPlayer();
-        game->enemies = InitEnemyManager(enemyCount);
-        StopMusicStream(game->backgroundMusic);
-        PlayMusicStream(game->backgroundMusic);
-        DisableCursor();
-        game->state = STATE_PLAYING;
+        StartLevel(game);
     }
 }
 
-static void UpdatePlaying(Game *game) {
-    float dt = GetFrameTime();
-
-    UpdatePlayer(&game->player, &game->camera);
+static int CompareStrings(const void *a, const void *b) {
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
 
-    // Walking sound - play when moving on ground
-    bool isMoving = (IsKeyDown(KEY_W) || IsKeyDown(KEY_S) || IsKeyDown(KEY_A) || IsKeyDown(KEY_D));
-    if (isMoving && game->player.isGrounded) {
-        if (!IsSoundPlaying(game->walkingSound)) {
-            PlaySound(game->walkingSound);
-        }
-    } else {
-        StopSound(game->walkingSound);
+// Lists the level files on disk. Each is mapped just long enough to read its name and waves.
+static void FindLevels(Game *game) {
+    game->levelCount = 0;
+    if (!DirectoryExists(LEVEL_DIRECTORY)) {
+        TraceLog(LOG_WARNING, "LEVEL: No %s directory, nothing to play", LEVEL_DIRECTORY);
+        return;
     }
 
-    // Update enemies
-    UpdateEnemies(&game->enemies, game->player.position, dt);
-
-    // Handle charge and throw input
-    if (!game->frisbee.inFlight && !game->player.isThrowing) {
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            // Start charging
-            game->player.isCharging = true;
-            game->player.chargeTime = 0.0f;
-        }
+    FilePathList files = LoadDirectoryFilesEx(LEVEL_DIRECTORY, LEVEL_EXTENSION, false);
+    qsort(files.paths, files.count, sizeof(char *), CompareStrings);
 
-        if (game->player.isCharging && IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
-            // Accumulate charge
-            game->player.chargeTime += dt;
-            if (game->player.chargeTime > MAX_CHARGE_TIME) {
-                game->player.chargeTime = MAX_CHARGE_TIME;
-            }
+    for (unsigned int i = 0; i < files.count && game->levelCount < MAX_LEVELS; i++) {
+        const char *file = GetFileNameWithoutExt(files.paths[i]);
+        Level level;
+        if (strlen(file) >= LEVEL_NAME_SIZE || strlen(files.paths[i]) >= sizeof(game->levels[0].path)) {
+            TraceLog(LOG_WARNING, "LEVEL: Skipping %s, name too long", files.paths[i]);
+            continue;
         }
+        if (!LoadLevel(&level, files.paths[i])) continue;
+
+        LevelInfo *info = &game->levels[game->levelCount++];
+        snprintf(info->path, sizeof(info->path), "%s", files.paths[i]);
+        snprintf(info->file, sizeof(info->file), "%s", file);
+        snprintf(info->name, sizeof(info->name), "%s", level.header->name);
+        info->waveCount = (int)level.header->waves.count;
+        info->enemyCount = GetLevelEnemyCount(&level);
+        UnloadLevel(&level);
+    }
+    if (files.count > MAX_LEVELS) {
+        TraceLog(LOG_WARNING, "LEVEL: Only the first %d of %u levels are listed", MAX_LEVELS, files.count);
+    }
+    UnloadDirectoryFiles(files);
+}
 
-        if (game->player.isCharging && IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
-            // Release throw
-            float chargePercent = game->player.chargeTime / MAX_CHARGE_TIME;
-            ThrowFrisbee(&game->frisbee, &game->player, game->camera, chargePercent);
-            SetSoundVolume(game->throwSound, 0.3f + 0.7f * chargePercent);
-            PlaySound(game->throwSound);
-            game->player.isCharging = false;
-            game->player.chargeTime = 0.0f;
-        }
+static int FindLevelByFile(const Game *game, const char *file) {
+    for (int i = 0; i < game->levelCount; i++) {
+        if (strcmp(game->levels[i].file, file) == 0) return i;
     }
+    return -1;
+}
+
+static void LoadAudioCues(Game *game) {
+    // Player feedback outranks the crowd; enemy sounds fade out across the arena
+    SetAudioCue(&game->audio, AUDIO_CUE_PLAYER_DEATH, game->deathSounds, 2, 4, 1.0f, 0.0f);
+    SetAudioCue(&game->audio, AUDIO_CUE_PLAYER_HIT, game->damageSounds, 2, 3, 1.0f, 0.0f);
+    SetAudioCue(&game->audio, AUDIO_CUE_THROW, &game->throwSound, 1, 2, 1.0f, 0.0f);
+    SetAudioCue(&game->audio, AUDIO_CUE_ENEMY_DEATH, game->deathSounds, 2, 2, 1.0f, ENEMY_SOUND_DISTANCE);
+    SetAudioCue(&game->audio, AUDIO_CUE_ENEMY_HIT, game->damageSounds, 2, 1, 1.0f, ENEMY_SOUND_DISTANCE);
+}
 
-    // Update frisbee physics
-    UpdateFrisbee(&game->frisbee, dt);
+// "runs/play.rpl" becomes "runs/play-3.rpl" for the third level recorded
+static void FormatReplayTakePath(char *out, size_t size, const char *path, int take) {
+    const char *slash = strrchr(path, '/');
+    const char *dot = strrchr(path, '.');
+    if (!dot || (slash && dot < slash)) dot = path + strlen(path);
+    snprintf(out, size, "%.*s-%d%s", (int)(dot - path), path, take, dot);
+}
 
-    // Frisbee-enemy collision
-    if (game->frisbee.inFlight) {
-        int hitResult = CheckFrisbeeEnemyCollision(&game->enemies, game->frisbee.position, 0.15f);
-        if (hitResult > 0) {
-            ResetFrisbee(&game->frisbee);
-            game->enemiesRemaining = game->enemies.aliveCount;
-            if (hitResult == 2) {
-                PlaySound(game->deathSounds[rand() % 2]);
+static void StartLevel(Game *game) {
+    uint32_t seed = (uint32_t)time(NULL);
+
+    EndReplay(game);  // Stops the sim thread, so the sim below is ours to replace
+    if (game->replayMode == REPLAY_MODE_PLAYBACK) {
+        if (OpenReplayPlayback(&game->replay, game->replayPath)) {
+            int level = FindLevelByFile(game, game->replay.header.levelFile);
+            if (level >= 0) {
+                seed = game->replay.header.seed;
+                game->selectedLevel = level;
+                TraceLog(LOG_INFO, "REPLAY: Playing %s (%u frames)", game->replayPath, game->replay.header.frameCount);
             } else {
-                PlaySound(game->damageSounds[rand() % 2]);
+                TraceLog(LOG_WARNING, "REPLAY: Level %s not found, playing live", game->replay.header.levelFile);
+                CloseReplay(&game->replay, 0);
             }
+        } else {
+            TraceLog(LOG_WARNING, "REPLAY: Could not read %s, playing live", game->replayPath);
         }
+        game->replayMode = REPLAY_MODE_NONE;  // Once
     }
 
-    // Enemy-player collision
-    int damage = CheckEnemyPlayerCollision(&game->enemies, game->player.position, PLAYER_COLLISION_RADIUS, dt);
-    if (damage > 0) {
-        game->player.health -= damage;
-        game->player.damageFlash = 0.3f;
-        PlaySound(game->damageSounds[rand() % 2]);
+    if (game->levelCount == 0) {
+        CloseReplay(&game->replay, 0);
+        game->state = STATE_LEVEL_SELECT;
+        return;
     }
 
-    // Update damage flash
-    if (game->player.damageFlash > 0.0f) {
-        game->player.damageFlash -= dt;
+    LevelInfo *level = &game->levels[game->selectedLevel];
+    if (game->replayMode == REPLAY_MODE_RECORD) {
+        char path[512];
+        FormatReplayTakePath(path, sizeof(path), game->replayPath, ++game->replayTakes);
+        if (OpenReplayRecording(&game->replay, path, level->file, seed)) {
+            TraceLog(LOG_INFO, "REPLAY: Recording %s to %s", level->file, path);
+        } else {
+            TraceLog(LOG_WARNING, "REPLAY: Could not write %s", path);
+        }
     }
 
-    // Win/lose conditions
-    if (game->player.health <= 0) {
-        EnableCursor();
-        StopMusicStream(game->backgroundMusic);
-        PlaySound(game->deathSounds[rand() % 2]);
-        game->state = STATE_GAME_OVER;
-    }
-    if (game->enemies.aliveCount <= 0) {
-        EnableCursor();
-        StopMusicStream(game->backgroundMusic);
-        game->state = STATE_VICTORY;
+    UnloadArenaMap(&game->arena);
+    UnloadSim(&game->sim);
+    bool loaded = InitSim(&game->sim, level->path, seed);
+    LoadArenaMap(&game->arena, &game->sim.world, game->sim.player.position);
+    if (!loaded) {
+        CloseReplay(&game->replay, 0);
+        game->state = STATE_LEVEL_SELECT;
+        return;
     }
+    game->enemiesRemaining = GetSimEnemiesRemaining(&game->sim);
+    RestartRenderScaler(&game->renderScale);  // Loading the level is not drawing time
+    StartSimThread(&game->simThread, &game->sim, &game->replay);
+    game->snapshot = AcquireSimSnapshot(&game->simThread);
+    StopMusicStream(game->backgroundMusic);
+    PlayMusicStream(game->backgroundMusic);
+    DisableCursor();
+    game->state = STATE_PLAYING;
+}
 
-    // Update throw animation timer
-    if (game->player.isThrowing) {
-        game->player.throwTimer -= dt;
-        if (game->player.throwTimer <= 0) {
-            game->player.isThrowing = false;
-        }
+static PlayerInput ReadPlayerInput(void) {
+    PlayerInput input = {0};
+    input.lookDelta = GetMouseDelta();
+    input.moveForward = IsKeyDown(KEY_W);
+    input.moveBack = IsKeyDown(KEY_S);
+    input.moveLeft = IsKeyDown(KEY_A);
+    input.moveRight = IsKeyDown(KEY_D);
+    input.sprint = IsKeyDown(KEY_LEFT_SHIFT);
+    input.jump = IsKeyPressed(KEY_SPACE);
+    input.throwPressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
+    input.throwHeld = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+    input.throwReleased = IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
+    input.cycleThrowMode = IsKeyPressed(KEY_TAB);
+    return input;
+}
+
+// Finishes the level's recording or reports how its playback went
+static void EndReplay(Game *game) {
+    // The checksum needs the sim to itself, and the replay is written from its thread
+    StopSimThread(&game->simThread);
+    if (!game->replay.file) return;
+
+    uint32_t checksum = GetSimChecksum(&game->sim);
+    if (game->replay.recording) {
+        TraceLog(LOG_INFO, "REPLAY: Recorded %u frames, checksum %08x", game->replay.framesDone, checksum);
+    } else if (game->replay.header.checksum != 0) {
+        TraceLog(game->replay.header.checksum == checksum ? LOG_INFO : LOG_WARNING,
+                 "REPLAY: Played %u frames, checksum %08x, recorded %08x", game->replay.framesDone, checksum,
+                 game->replay.header.checksum);
     }
+    CloseReplay(&game->replay, checksum);
 }
 
-static void DrawTitleScreen(void) {
-    const char *title = "FRISBEE TAKEDOWN";
-    const char *prompt = "Press any key to continue";
+static void UpdatePlaying(Game *game) {
+    if (!game->replay.file || game->replay.recording) {
+        PlayerInput input = ReadPlayerInput();
+        PostSimInput(&game->simThread, &input);
+    }
+    PumpSimThread(&game->simThread);
+
+    // One snapshot for the whole frame, so the HUD and the scene agree
+    game->snapshot = AcquireSimSnapshot(&game->simThread);
+    game->enemiesRemaining = game->snapshot->enemiesRemaining;
 
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
+    SimEvents events;
+    TakeSimEvents(&game->simThread, &events);
+    HandleSimEvents(game, &events);
+    if (game->state != STATE_PLAYING) return;
 
-    int titleFontSize = 60;
-    int promptFontSize = 20;
+    if (GetSimThreadStatus(&game->simThread) == SIM_THREAD_REPLAY_ENDED) {
+        // Recording ran out before the level ended
+        EndReplay(game);
+        StopSound(game->walkingSound);
+        EnableCursor();
+        game->state = STATE_TITLE;
+        return;
+    }
 
-    int titleWidth = MeasureText(title, titleFontSize);
-    int promptWidth = MeasureText(prompt, promptFontSize);
+    PROFILE_BEGIN("Streaming");
+    UpdateArenaMap(&game->arena, game->snapshot->player.position);
+    PROFILE_END();
 
-    DrawText(title, (screenWidth - titleWidth) / 2, screenHeight / 2 - 50, titleFontSize, WHITE);
-    DrawText(prompt, (screenWidth - promptWidth) / 2, screenHeight / 2 + 30, promptFontSize, LIGHTGRAY);
+    UpdateAudioMixer(&game->audio, game->snapshot->camera);
 }
 
-static void DrawLevelSelect(Game *game) {
-    const char *header = "SELECT LEVEL";
+// Audio cues and level transitions for the ticks finished since the last frame
+static void HandleSimEvents(Game *game, const SimEvents *events) {
+    PROFILE_BEGIN("Audio");
 
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
+    // Walking sound - play when moving on ground
+    if (events->walking) {
+        if (!IsSoundPlaying(game->walkingSound)) {
+            PlaySound(game->walkingSound);
+        }
+    } else {
+        StopSound(game->walkingSound);
+    }
 
-    int headerFontSize = 40;
-    int levelFontSize = 30;
+    for (int i = 0; i < events->count; i++) {
+        const SimEvent *event = &events->events[i];
+        switch (event->type) {
+            case SIM_EVENT_THROW:
+                PlayAudioCue(&game->audio, AUDIO_CUE_THROW, event->position, 0.3f + 0.7f * event->value);
+                break;
+            case SIM_EVENT_ENEMY_DAMAGED:
+                PlayAudioCue(&game->audio, AUDIO_CUE_ENEMY_HIT, event->position, 1.0f);
+                break;
+            case SIM_EVENT_ENEMY_KILLED:
+                PlayAudioCue(&game->audio, AUDIO_CUE_ENEMY_DEATH, event->position, 1.0f);
+                break;
+            case SIM_EVENT_PLAYER_DAMAGED:
+                PlayAudioCue(&game->audio, AUDIO_CUE_PLAYER_HIT, event->position, 1.0f);
+                break;
+            case SIM_EVENT_PLAYER_KILLED:
+                EnableCursor();
+                StopMusicStream(game->backgroundMusic);
+                PlayAudioCue(&game->audio, AUDIO_CUE_PLAYER_DEATH, event->position, 1.0f);
+                EndReplay(game);
+                game->state = STATE_GAME_OVER;
+                break;
+            case SIM_EVENT_WAVE_STARTED:
+                break;
+            case SIM_EVENT_ALL_ENEMIES_KILLED:
+                EnableCursor();
+                StopMusicStream(game->backgroundMusic);
+                EndReplay(game);
+                game->state = STATE_VICTORY;
+                break;
+        }
+    }
+    PROFILE_END();
+}
 
-    int headerWidth = MeasureText(header, headerFontSize);
-    DrawText(header, (screenWidth - headerWidth) / 2, screenHeight / 2 - 120, headerFontSize, WHITE);
+// Clears the UI layer when the screen or the window size changed since it was built.
+// Returns true when the caller should add its widgets again.
+static bool BeginUiScreen(Game *game) {
+    if (game->uiWidgets.screen == (int)game->state && IsUiLayoutCurrent(&game->ui)) return false;
+    ClearUiLayer(&game->ui);
+    game->uiWidgets.screen = game->state;
+    return true;
+}
+
+static void DrawTitleScreen(Game *game) {
+    UiLayer *ui = &game->ui;
+    GameUi *widgets = &game->uiWidgets;
+    if (BeginUiScreen(game)) {
+        int centerX = ui->width / 2;
+        int centerY = ui->height / 2;
+        AddUiLabel(ui, "FRISBEE TAKEDOWN", 60, WHITE, UI_ALIGN_CENTER, centerX, centerY - 50);
+        widgets->prompt = AddUiLabel(ui, "", 20, LIGHTGRAY, UI_ALIGN_CENTER, centerX, centerY + 30);
+    }
 
-    for (int i = 1; i <= 3; i++) {
-        char levelText[64];
-        snprintf(levelText, sizeof(levelText), "Level %d - %d Enemies", i, LEVEL_ENEMY_COUNTS[i - 1]);
+    if (AreAssetsReady(&game->assets)) {
+        SetUiLabel(ui, widgets->prompt, "Press any key to continue", NULL, 0);
+    } else {
+        int percent = (int)(GetAssetProgress(&game->assets) * 100.0f);
+        SetUiLabel(ui, widgets->prompt, "Loading... %d%%", &percent, 1);
+    }
+    DrawUiLayer(ui);
+}
 
-        int levelWidth = MeasureText(levelText, levelFontSize);
-        int y = screenHeight / 2 - 40 + (i - 1) * 50;
+static void DrawLevelSelect(Game *game) {
+    UiLayer *ui = &game->ui;
+    GameUi *widgets = &game->uiWidgets;
+    if (BeginUiScreen(game)) {
+        int centerX = ui->width / 2;
+        int top = ui->height / 2 - 40;
+        int levelFontSize = 30;
+        AddUiLabel(ui, "SELECT LEVEL", 40, WHITE, UI_ALIGN_CENTER, centerX, top - 80);
+
+        if (game->levelCount == 0) {
+            AddUiLabel(ui, "No levels found in " LEVEL_DIRECTORY "/", levelFontSize, LIGHTGRAY, UI_ALIGN_CENTER,
+                       centerX, top);
+        } else {
+            widgets->firstLevel = ui->widgetCount;
+            for (int i = 0; i < game->levelCount; i++) {
+                LevelInfo *level = &game->levels[i];
+                char levelText[UI_TEXT_SIZE];
+                if (level->waveCount > 1) {
+                    snprintf(levelText, sizeof(levelText), "%d. %s - %d Enemies in %d Waves", i + 1, level->name,
+                             level->enemyCount, level->waveCount);
+                } else {
+                    snprintf(levelText, sizeof(levelText), "%d. %s - %d Enemies", i + 1, level->name,
+                             level->enemyCount);
+                }
+                AddUiLabel(ui, levelText, levelFontSize, LIGHTGRAY, UI_ALIGN_CENTER, centerX, top + i * 50);
+            }
 
-        Color color = (i == game->selectedLevel) ? YELLOW : LIGHTGRAY;
-        DrawText(levelText, (screenWidth - levelWidth) / 2, y, levelFontSize, color);
+            char instructions[64];
+            snprintf(instructions, sizeof(instructions), "Use Arrow Keys or 1-%d, Enter to Start", game->levelCount);
+            AddUiLabel(ui, instructions, 18, GRAY, UI_ALIGN_CENTER, centerX, top + game->levelCount * 50 + 20);
+        }
     }
 
-    const char *instructions = "Use Arrow Keys or 1-3, Enter to Start";
-    int instrFontSize = 18;
-    int instrWidth = MeasureText(instructions, instrFontSize);
-    DrawText(instructions, (screenWidth - instrWidth) / 2, screenHeight / 2 + 130, instrFontSize, GRAY);
+    for (int i = 0; i < game->levelCount; i++) {
+        SetUiColor(ui, widgets->firstLevel + i, (i == game->selectedLevel) ? YELLOW : LIGHTGRAY);
+    }
+    DrawUiLayer(ui);
 }
 
 static void DrawHUD(Game *game) {
-    char hudText[32];
-    snprintf(hudText, sizeof(hudText), "Enemies Left: %d", game->enemiesRemaining);
-    DrawText(hudText, 10, 35, 20, WHITE);
+    UiLayer *ui = &game->ui;
+    GameUi *widgets = &game->uiWidgets;
+    if (BeginUiScreen(game)) {
+        widgets->enemies = AddUiLabel(ui, "", 20, WHITE, UI_ALIGN_LEFT, 10, 35);
+        widgets->throwMode = AddUiLabel(ui, "", 20, WHITE, UI_ALIGN_LEFT, 10, 60);
+        // Player health bar (top-right), labelled in its middle
+        Rectangle healthBar = {(float)(ui->width - 150 - 20), 10, 150, 20};
+        widgets->healthBar = AddUiBar(ui, healthBar, GREEN);
+        widgets->health = AddUiLabel(ui, "", 16, WHITE, UI_ALIGN_CENTER, (int)(healthBar.x + healthBar.width / 2),
+                                     (int)healthBar.y + 2);
+    }
+
+    int waveCount = game->levels[game->selectedLevel].waveCount;
+    if (waveCount > 1) {
+        int values[3] = {game->enemiesRemaining, game->snapshot->wave, waveCount};
+        SetUiLabel(ui, widgets->enemies, "Enemies Left: %d  Wave %d/%d", values, 3);
+    } else {
+        SetUiLabel(ui, widgets->enemies, "Enemies Left: %d", &game->enemiesRemaining, 1);
+    }
 
-    // Draw player health bar (top-right)
-    int screenWidth = GetScreenWidth();
-    int healthBarWidth = 150;
-    int healthBarHeight = 20;
-    int healthBarX = screenWidth - healthBarWidth - 20;
-    int healthBarY = 10;
+    // Whole strings, so a change of mode is one pointer compare
+    static const char *throwModeLabels[THROW_MODE_COUNT] = {
+        "Throw: Single (Tab)", "Throw: Multi (Tab)", "Throw: Spread (Tab)", "Throw: Rapid (Tab)"};
+    SetUiLabel(ui, widgets->throwMode, throwModeLabels[game->snapshot->throwMode], NULL, 0);
 
-    float healthPercent = (float)game->player.health / game->player.maxHealth;
+    const Player *player = &game->snapshot->player;
+    float healthPercent = (float)player->health / player->maxHealth;
 
     // Determine health bar color based on percentage
     Color healthColor;
@@ -317,29 +572,24 @@ static void DrawHUD(Game *game) {
     } else {
         healthColor = RED;
     }
+    SetUiBarFill(ui, widgets->healthBar, healthPercent);
+    SetUiColor(ui, widgets->healthBar, healthColor);
+    int health[2] = {player->health, player->maxHealth};
+    SetUiLabel(ui, widgets->health, "HP: %d/%d", health, 2);
 
-    // Background
-    DrawRectangle(healthBarX - 2, healthBarY - 2, healthBarWidth + 4, healthBarHeight + 4, DARKGRAY);
-    // Fill
-    DrawRectangle(healthBarX, healthBarY, (int)(healthBarWidth * healthPercent), healthBarHeight, healthColor);
-    // Border
-    DrawRectangleLines(healthBarX - 2, healthBarY - 2, healthBarWidth + 4, healthBarHeight + 4, WHITE);
-
-    // Health label
-    char healthText[16];
-    snprintf(healthText, sizeof(healthText), "HP: %d/%d", game->player.health, game->player.maxHealth);
-    int textWidth = MeasureText(healthText, 16);
-    DrawText(healthText, healthBarX + (healthBarWidth - textWidth) / 2, healthBarY + 2, 16, WHITE);
+    DrawUiLayer(ui);
 
-    // Draw charge bar when charging
-    if (game->player.isCharging) {
+    // Draw charge bar when charging. It moves every frame while shown, so it is drawn
+    // directly rather than through the layer.
+    if (player->isCharging) {
+        int screenWidth = GetScreenWidth();
         int screenHeight = GetScreenHeight();
         int barWidth = 200;
         int barHeight = 10;
         int barX = (screenWidth - barWidth) / 2;
         int barY = screenHeight - 50;
 
-        float chargePercent = game->player.chargeTime / MAX_CHARGE_TIME;
+        float chargePercent = player->chargeTime / MAX_CHARGE_TIME;
 
         // Background
         DrawRectangle(barX - 2, barY - 2, barWidth + 4, barHeight + 4, DARKGRAY);
@@ -359,59 +609,109 @@ static void UpdateGameOver(Game *game) {
 static void UpdateVictory(Game *game) {
     if (IsKeyPressed(KEY_ENTER)) {
         // Next level
-        if (game->selectedLevel < 3) {
+        if (game->selectedLevel < game->levelCount - 1) {
             game->selectedLevel++;
         }
-        int enemyCount = LEVEL_ENEMY_COUNTS[game->selectedLevel - 1];
-        game->enemiesRemaining = enemyCount;
-        game->camera = InitCamera();
-        game->frisbee = InitFrisbee();
-        game->player = InitPlayer();
-        game->enemies = InitEnemyManager(enemyCount);
-        StopMusicStream(game->backgroundMusic);
-        PlayMusicStream(game->backgroundMusic);
-        DisableCursor();
-        game->state = STATE_PLAYING;
+        StartLevel(game);
     }
     if (IsKeyPressed(KEY_Q) || IsKeyPressed(KEY_ESCAPE)) {
         game->state = STATE_LEVEL_SELECT;
     }
 }
 
-static void DrawGameOver(void) {
-    const char *title = "GAME OVER";
-    const char *prompt = "Press ENTER to return to menu";
-
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
-
-    int titleFontSize = 60;
-    int promptFontSize = 20;
+static void DrawGameOver(Game *game) {
+    UiLayer *ui = &game->ui;
+    if (BeginUiScreen(game)) {
+        int centerX = ui->width / 2;
+        int centerY = ui->height / 2;
+        AddUiLabel(ui, "GAME OVER", 60, RED, UI_ALIGN_CENTER, centerX, centerY - 50);
+        AddUiLabel(ui, "Press ENTER to return to menu", 20, LIGHTGRAY, UI_ALIGN_CENTER, centerX, centerY + 30);
+    }
+    DrawUiLayer(ui);
+}
 
-    int titleWidth = MeasureText(title, titleFontSize);
-    int promptWidth = MeasureText(prompt, promptFontSize);
+static void DrawVictory(Game *game) {
+    UiLayer *ui = &game->ui;
+    if (BeginUiScreen(game)) {
+        char nextPrompt[64] = "Press ENTER for next level";
+        if (game->selectedLevel >= game->levelCount - 1) {
+            snprintf(nextPrompt, sizeof(nextPrompt), "Press ENTER to replay %s",
+                     game->levels[game->selectedLevel].name);
+        }
 
-    DrawText(title, (screenWidth - titleWidth) / 2, screenHeight / 2 - 50, titleFontSize, RED);
-    DrawText(prompt, (screenWidth - promptWidth) / 2, screenHeight / 2 + 30, promptFontSize, LIGHTGRAY);
+        int centerX = ui->width / 2;
+        int centerY = ui->height / 2;
+        AddUiLabel(ui, "VICTORY!", 60, YELLOW, UI_ALIGN_CENTER, centerX, centerY - 50);
+        AddUiLabel(ui, nextPrompt, 20, LIGHTGRAY, UI_ALIGN_CENTER, centerX, centerY + 30);
+        AddUiLabel(ui, "Press Q to return to menu", 20, GRAY, UI_ALIGN_CENTER, centerX, centerY + 60);
+    }
+    DrawUiLayer(ui);
 }
 
-static void DrawVictory(Game *game) {
-    const char *title = "VICTORY!";
-    const char *nextPrompt = game->selectedLevel < 3 ?
-        "Press ENTER for next level" : "Press ENTER to replay level 3";
-    const char *quitPrompt = "Press Q to return to menu";
+static void DrawProfilerOverlay(Game *game) {
+    int x = GetScreenWidth() - 360;
+    int y = 50;
+    int lineHeight = 18;
+    ProfileZoneStats stats[PROFILE_MAX_STAT_ZONES];
+    int statCount = GetProfileStats(stats, PROFILE_MAX_STAT_ZONES);
+    int lines = (statCount > 0 ? statCount : 1) + 10;
 
-    int screenWidth = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
+    DrawRectangle(x - 10, y - 10, 350, lines * lineHeight + 20, (Color){0, 0, 0, 180});
 
-    int titleFontSize = 60;
-    int promptFontSize = 20;
+    if (!IsProfilerEnabled()) {
+        DrawText("Profiler compiled out (FRISBEE_PROFILE)", x, y, 16, YELLOW);
+        y += lineHeight;
+    }
 
-    int titleWidth = MeasureText(title, titleFontSize);
-    int nextWidth = MeasureText(nextPrompt, promptFontSize);
-    int quitWidth = MeasureText(quitPrompt, promptFontSize);
+    char line[96];
+    DrawText("Zone                  ms    avg", x, y, 16, LIGHTGRAY);
+    y += lineHeight;
+    for (int i = 0; i < statCount; i++) {
+        snprintf(line, sizeof(line), "%*s%-*s %6.2f %6.2f", stats[i].depth * 2, "", 20 - stats[i].depth * 2,
+                 stats[i].name, stats[i].ms, stats[i].averageMs);
+        DrawText(line, x, y, 16, WHITE);
+        y += lineHeight;
+    }
 
-    DrawText(title, (screenWidth - titleWidth) / 2, screenHeight / 2 - 50, titleFontSize, YELLOW);
-    DrawText(nextPrompt, (screenWidth - nextWidth) / 2, screenHeight / 2 + 30, promptFontSize, LIGHTGRAY);
-    DrawText(quitPrompt, (screenWidth - quitWidth) / 2, screenHeight / 2 + 60, promptFontSize, GRAY);
+    y += lineHeight / 2;
+    RenderStats *render = &game->renderStats;
+    snprintf(line, sizeof(line), "Enemies drawn %d/%d", render->enemies.drawn, render->enemies.considered);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    int *lodCounts = game->enemyRenderer.lodCounts;
+    snprintf(line, sizeof(line), "  LOD full %d  simple %d  box %d",
+             lodCounts[ENEMY_LOD_FULL], lodCounts[ENEMY_LOD_SIMPLE], lodCounts[ENEMY_LOD_BOX]);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "Arena chunks drawn %d/%d", render->arena.drawn, render->arena.considered);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    ArenaMap *arena = &game->arena;
+    snprintf(line, sizeof(line), "  resident %d  pending %d  uploaded %d  dormant enemies %d", arena->residentCount,
+             arena->pendingCount, arena->uploadCount, game->snapshot->dormantCount);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "Frisbees drawn %d/%d", render->effects.drawn, render->effects.considered);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    AudioStats *audio = &game->audio.stats;
+    snprintf(line, sizeof(line), "Voices %d/%d  merged %d  culled %d", audio->activeVoices, AUDIO_VOICE_BUDGET,
+             audio->merged, audio->culled);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    static const char *decisionNames[] = {"hold", "down", "up", "fixed"};
+    RenderScaler *scale = &game->renderScale;
+    snprintf(line, sizeof(line), "Render scale %.2f (%dx%d) of %.2f-%.2f", scale->scale,
+             GetScaledRenderWidth(scale), GetScaledRenderHeight(scale), scale->minScale, scale->maxScale);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "  %.1f/%.1f ms  %s from %.2f at %.1f ms, %d changes",
+             scale->averageFrameTime * 1000.0f, scale->frameBudget * 1000.0f, decisionNames[scale->decision],
+             scale->previousScale, scale->changeFrameTime * 1000.0f, scale->changes);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    snprintf(line, sizeof(line), "UI widgets %d  redrawn %d times", game->ui.widgetCount, game->ui.renders);
+    DrawText(line, x, y, 16, WHITE);
+    y += lineHeight;
+    DrawText("F4: dump trace", x, y, 16, LIGHTGRAY);
 }
@@ -2,9 +2,16 @@
 #define GAME_H
 
 #include "raylib.h"
-#include "frisbee.h"
-#include "player.h"
-#include "enemy.h"
+#include "sim.h"
+#include "simthread.h"
+#include "enemy_draw.h"
+#include "frustum.h"
+#include "map.h"
+#include "assets.h"
+#include "audio.h"
+#include "replay.h"
+#include "ui.h"
+#include "render_scale.h"
 
 typedef enum {
     STATE_TITLE,
@@ -14,25 +21,82 @@ typedef enum {
     STATE_VICTORY
 } GameState;
 
+typedef enum {
+    REPLAY_MODE_NONE,
+    REPLAY_MODE_RECORD,    // Write each level played to its own file, numbered after the replay path
+    REPLAY_MODE_PLAYBACK   // Play the replay file once, in place of live input
+} ReplayMode;
+
+#define MAX_LEVELS 9  // One per number key in the level select
+
+// A level file found at startup, summarized for the level select
+typedef struct {
+    char path[256];
+    char file[LEVEL_NAME_SIZE];  // File name without extension, as stored in replays
+    char name[LEVEL_NAME_SIZE];
+    int waveCount;
+    int enemyCount;
+} LevelInfo;
+
+// Objects considered and drawn by the culling pass in the last frame
+typedef struct {
+    CullStats enemies;
+    CullStats arena;    // Resident chunks of ground, trees and walls
+    CullStats effects;  // Held frisbee plus those in flight
+} RenderStats;
+
+// Widgets in the UI layer that change while their screen is up
+typedef struct {
+    int screen;      // GameState the layer was built for, -1 before the first build
+    int prompt;      // Title: asset loading progress, then the prompt
+    int firstLevel;  // Level select: one label per level, in order
+    int enemies;     // HUD
+    int throwMode;
+    int healthBar;
+    int health;
+} GameUi;
+
 typedef struct {
     GameState state;
-    int selectedLevel;
+    LevelInfo levels[MAX_LEVELS];  // Every level file in LEVEL_DIRECTORY, sorted by file name
+    int levelCount;
+    int selectedLevel;             // Index into levels
     int enemiesRemaining;
-    Camera camera;
-    Frisbee frisbee;
-    Player player;
-    EnemyManager enemies;
-    // Audio
+    Sim sim;                       // Owned by simThread while a level is playing
+    SimThread simThread;
+    const SimSnapshot *snapshot;   // What this frame draws, taken once in UpdateGame
+    EnemyRenderer enemyRenderer;
+    ArenaMap arena;
+    RenderStats renderStats;
+    RenderScaler renderScale;  // Resolution of the 3D pass; the HUD is always drawn at full size
+    UiLayer ui;          // Menus and HUD, redrawn only when what they show changes
+    GameUi uiWidgets;
+    bool showProfiler;  // F3 toggles the zone timing overlay
+    bool firstFrameDrawn;
+    ReplayMode replayMode;
+    const char *replayPath;
+    int replayTakes;    // Levels recorded so far
+    Replay replay;
+    // Audio, filled in by the asset loader as it finishes
+    AssetLoader assets;
+    AudioMixer audio;    // Voices for one-shot cues, created once the sounds are loaded
     Music backgroundMusic;
     Sound throwSound;
     Sound damageSounds[2];
     Sound deathSounds[2];
-    Sound walkingSound;
+    Sound walkingSound;  // Looping footsteps, played directly rather than through the mixer
 } Game;
 
-Game InitGame(void);
+// Game owns a loader thread that writes into it, so it is initialized in place
+void InitGame(Game *game);
+// Call after InitGame. Playback starts the recorded level as soon as assets are ready.
+void SetGameReplay(Game *game, ReplayMode mode, const char *path);
+// Call after InitGame. Bounds the 3D pass's resolution scale, chosen to draw each frame
+// within frameBudget seconds.
+void SetGameRenderScale(Game *game, float minScale, float maxScale, float frameBudget);
+// Once per frame: menus, input, sim events and streaming. The sim ticks on its own thread.
 void UpdateGame(Game *game);
 void DrawGame(Game *game);
-void UnloadGameAudio(Game *game);
+void UnloadGame(Game *game);
 
 #endif
@@ -0,0 +1,188 @@
+#include "jobs.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+typedef struct {
+    JobRangeFunc func;
+    void *context;
+    int begin;
+    int end;
+    int grain;
+    atomic_int *remaining;  // Items of the ParallelFor not yet finished
+} Job;
+
+// The owner pushes and pops at the bottom; thieves take from the top, where the biggest
+// halves of a split range sit. A plain lock per deque is cheap at a handful of jobs per range.
+typedef struct {
+    pthread_mutex_t lock;
+    Job jobs[JOB_DEQUE_SIZE];
+    int top;
+    int bottom;
+} JobDeque;
+
+// Deque 0 belongs to whichever thread calls ParallelFor; workers own 1..jobWorkerCount
+static JobDeque jobDeques[MAX_JOB_WORKERS + 1];
+static pthread_t jobThreads[MAX_JOB_WORKERS];
+static int jobWorkerCount;
+static bool jobSystemRunning;
+static atomic_int jobsQueued;  // Never below the number of jobs sitting in deques
+static atomic_bool jobShutdown;
+static pthread_mutex_t jobSleepLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobWake = PTHREAD_COND_INITIALIZER;
+static _Thread_local int jobDequeIndex;
+
+static bool PushJob(int index, const Job *job) {
+    JobDeque *deque = &jobDeques[index];
+    atomic_fetch_add(&jobsQueued, 1);
+
+    pthread_mutex_lock(&deque->lock);
+    bool pushed = deque->bottom - deque->top < JOB_DEQUE_SIZE;
+    if (pushed) deque->jobs[deque->bottom++ % JOB_DEQUE_SIZE] = *job;
+    pthread_mutex_unlock(&deque->lock);
+
+    if (!pushed) {
+        atomic_fetch_sub(&jobsQueued, 1);
+        return false;
+    }
+
+    pthread_mutex_lock(&jobSleepLock);
+    pthread_cond_signal(&jobWake);
+    pthread_mutex_unlock(&jobSleepLock);
+    return true;
+}
+
+static bool TakeJob(int index, bool steal, Job *job) {
+    JobDeque *deque = &jobDeques[index];
+
+    pthread_mutex_lock(&deque->lock);
+    bool taken = deque->bottom > deque->top;
+    if (taken) *job = steal ? deque->jobs[deque->top++ % JOB_DEQUE_SIZE] : deque->jobs[--deque->bottom % JOB_DEQUE_SIZE];
+    pthread_mutex_unlock(&deque->lock);
+
+    if (taken) atomic_fetch_sub(&jobsQueued, 1);
+    return taken;
+}
+
+static bool FindJob(int self, Job *job) {
+    if (TakeJob(self, false, job)) return true;
+
+    int dequeCount = jobWorkerCount + 1;
+    for (int k = 1; k < dequeCount; k++) {
+        if (TakeJob((self + k) % dequeCount, true, job)) return true;
+    }
+    return false;
+}
+
+static void RunJob(Job job) {
+    // Keep the front half, offer the back half to thieves, until the piece is one grain
+    while (job.end - job.begin > job.grain) {
+        int half = (job.end - job.begin) / 2;
+        int mid = job.begin + (half + job.grain - 1) / job.grain * job.grain;
+        if (mid >= job.end) break;
+
+        Job back = job;
+        back.begin = mid;
+        if (!PushJob(jobDequeIndex, &back)) break;
+        job.end = mid;
+    }
+
+    job.func(job.begin, job.end, job.context);
+    atomic_fetch_sub_explicit(job.remaining, job.end - job.begin, memory_order_release);
+}
+
+static void *JobWorker(void *context) {
+    jobDequeIndex = (int)(long)context;
+
+    while (!atomic_load(&jobShutdown)) {
+        Job job;
+        if (FindJob(jobDequeIndex, &job)) {
+            RunJob(job);
+            continue;
+        }
+
+        pthread_mutex_lock(&jobSleepLock);
+        while (!atomic_load(&jobShutdown) && atomic_load(&jobsQueued) == 0) {
+            pthread_cond_wait(&jobWake, &jobSleepLock);
+        }
+        pthread_mutex_unlock(&jobSleepLock);
+    }
+    return NULL;
+}
+
+// Wakes every worker to see the shutdown flag and joins the first `started` threads
+static void StopJobWorkers(int started) {
+    pthread_mutex_lock(&jobSleepLock);
+    atomic_store(&jobShutdown, true);
+    pthread_cond_broadcast(&jobWake);
+    pthread_mutex_unlock(&jobSleepLock);
+
+    for (int i = 0; i < started; i++) pthread_join(jobThreads[i], NULL);
+}
+
+void InitJobSystem(int workerCount) {
+    if (jobSystemRunning) return;
+
+    if (workerCount <= 0) workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN) - 1;
+    if (workerCount > MAX_JOB_WORKERS) workerCount = MAX_JOB_WORKERS;
+    if (workerCount < 0) workerCount = 0;
+
+    for (int i = 0; i <= MAX_JOB_WORKERS; i++) {
+        pthread_mutex_init(&jobDeques[i].lock, NULL);
+        jobDeques[i].top = 0;
+        jobDeques[i].bottom = 0;
+    }
+    atomic_store(&jobsQueued, 0);
+    atomic_store(&jobShutdown, false);
+    jobSystemRunning = true;
+
+    // Workers read jobWorkerCount to pick victims, so it is set before the first of them
+    // starts and never changes while they run
+    jobWorkerCount = workerCount;
+    for (int i = 0; i < workerCount; i++) {
+        if (pthread_create(&jobThreads[i], NULL, JobWorker, (void *)(long)(i + 1)) == 0) continue;
+
+        // Without every worker, run inline: stop the ones already started
+        StopJobWorkers(i);
+        atomic_store(&jobShutdown, false);
+        jobWorkerCount = 0;
+        return;
+    }
+}
+
+void ShutdownJobSystem(void) {
+    if (!jobSystemRunning) return;
+
+    StopJobWorkers(jobWorkerCount);
+    for (int i = 0; i <= MAX_JOB_WORKERS; i++) pthread_mutex_destroy(&jobDeques[i].lock);
+    jobWorkerCount = 0;
+    jobSystemRunning = false;
+}
+
+int GetJobWorkerCount(void) {
+    return jobWorkerCount;
+}
+
+void ParallelFor(int count, int grain, JobRangeFunc func, void *context) {
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    if (!jobSystemRunning || jobWorkerCount == 0 || count <= grain) {
+        func(0, count, context);
+        return;
+    }
+
+    atomic_int remaining = count;
+    RunJob((Job){func, context, 0, count, grain, &remaining});
+
+    // Help with whatever is left, ours or anyone's, until every chunk of this range is done
+    while (atomic_load_explicit(&remaining, memory_order_acquire) > 0) {
+        Job job;
+        if (FindJob(jobDequeIndex, &job)) {
+            RunJob(job);
+        } else {
+            sched_yield();
+        }
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#define MAX_JOB_WORKERS 32
+#define JOB_DEQUE_SIZE 256  // Splitting a range only ever queues about log2(count / grain) jobs per thread
+
+// Runs func over [begin, end) of a larger range; chunks of one ParallelFor may run at the same time
+typedef void (*JobRangeFunc)(int begin, int end, void *context);
+
+// Starts workerCount background threads (0 picks one per core, minus the calling thread).
+// If any thread fails to start, none are kept. Without a running job system, or with no
+// workers, ParallelFor runs inline.
+void InitJobSystem(int workerCount);
+void ShutdownJobSystem(void);
+int GetJobWorkerCount(void);
+// Fork-join over [0, count): the range is split in halves down to `grain` items, each thread
+// works through its own deque newest-first and steals the oldest (largest) halves from the
+// others when it runs dry. Chunk boundaries fall on multiples of grain. Returns when every
+// chunk has finished; the calling thread works too. Callers outside the pool share one
+// deque, so only one thread at a time may call it (during play, the sim thread).
+void ParallelFor(int count, int grain, JobRangeFunc func, void *context);
+
+#endif
@@ -0,0 +1,215 @@
+#include "level.h"
+#include <fcntl.h>
+#include <math.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Sections are read in place, so the file layout is the in-memory layout of this build
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Level files are little endian and mapped directly"
+#endif
+_Static_assert(sizeof(WorldBox) == 28, "WorldBox must match the level file box layout");
+_Static_assert(sizeof(Vector2) == 8, "Vector2 must match the level file tree layout");
+_Static_assert(sizeof(int) == sizeof(int32_t), "Grid sections are read as int");
+
+static bool IsSectionValid(const Level *level, LevelSection section, size_t elementSize) {
+    if (section.offset % 4 != 0 || section.offset > level->size) return false;
+    return section.count <= (level->size - section.offset) / elementSize;
+}
+
+static const void *SectionData(const Level *level, LevelSection section) {
+    return (const unsigned char *)level->data + section.offset;
+}
+
+// Offsets must climb from 0 to itemCount
+static bool IsOffsetListValid(const Level *level, LevelSection start, uint32_t itemCount) {
+    const int *offsets = SectionData(level, start);
+    if (offsets[0] != 0 || (uint32_t)offsets[start.count - 1] != itemCount) return false;
+    for (uint32_t c = 0; c + 1 < start.count; c++) {
+        if (offsets[c + 1] < offsets[c]) return false;
+    }
+    return true;
+}
+
+// Every item must also name an existing element, so lookups through the grid can never
+// leave the mapping
+static bool IsCellListValid(const Level *level, LevelSection start, LevelSection items, uint32_t elementCount) {
+    const int *cellItems = SectionData(level, items);
+    if (!IsOffsetListValid(level, start, items.count)) return false;
+    for (uint32_t i = 0; i < items.count; i++) {
+        if (cellItems[i] < 0 || (uint32_t)cellItems[i] >= elementCount) return false;
+    }
+    return true;
+}
+
+static const char *ValidateLevel(const Level *level) {
+    const LevelHeader *header = level->header;
+    if (level->size < sizeof(LevelHeader)) return "file too small";
+    if (header->magic != LEVEL_MAGIC) return "not a level file";
+    if (header->version != LEVEL_VERSION) return "unsupported version";
+    if (header->headerSize != sizeof(LevelHeader)) return "unexpected header size";
+    if (memchr(header->name, '\0', LEVEL_NAME_SIZE) == NULL) return "unterminated name";
+    if (header->cellSize != WORLD_CELL_SIZE || header->chunkCells != WORLD_CHUNK_CELLS) {
+        return "grid baked for a different cell or chunk size";
+    }
+    if (!(header->halfSize > 0.0f) || header->chunkDim <= 0 || header->chunkDim > 4096 / WORLD_CHUNK_CELLS ||
+        header->gridDim != header->chunkDim * WORLD_CHUNK_CELLS) {
+        return "bad arena size";
+    }
+
+    uint32_t cellCount = (uint32_t)header->gridDim * (uint32_t)header->gridDim;
+    uint32_t chunkCount = (uint32_t)header->chunkDim * (uint32_t)header->chunkDim;
+    if (!IsSectionValid(level, header->boxes, sizeof(WorldBox)) ||
+        !IsSectionValid(level, header->trees, sizeof(Vector2)) ||
+        !IsSectionValid(level, header->chunkBoxStart, sizeof(int32_t)) ||
+        !IsSectionValid(level, header->boxCellStart, sizeof(int32_t)) ||
+        !IsSectionValid(level, header->boxCellItems, sizeof(int32_t)) ||
+        !IsSectionValid(level, header->treeCellStart, sizeof(int32_t)) ||
+        !IsSectionValid(level, header->treeCellItems, sizeof(int32_t)) ||
+        !IsSectionValid(level, header->spawns, sizeof(LevelSpawn)) ||
+        !IsSectionValid(level, header->waves, sizeof(LevelWave))) {
+        return "section outside the file";
+    }
+    if (header->boxCellStart.count != cellCount + 1 || header->treeCellStart.count != cellCount + 1 ||
+        header->chunkBoxStart.count != chunkCount + 1) {
+        return "grid does not match the arena";
+    }
+    if (!IsOffsetListValid(level, header->chunkBoxStart, header->boxes.count)) return "corrupt chunk table";
+    if (!IsCellListValid(level, header->boxCellStart, header->boxCellItems, header->boxes.count) ||
+        !IsCellListValid(level, header->treeCellStart, header->treeCellItems, header->trees.count)) {
+        return "corrupt grid";
+    }
+
+    const LevelSpawn *spawns = SectionData(level, header->spawns);
+    for (uint32_t s = 0; s < header->spawns.count; s++) {
+        if (!isfinite(spawns[s].x) || !isfinite(spawns[s].z) || !(spawns[s].radius >= 0.0f) ||
+            !isfinite(spawns[s].radius)) {
+            return "bad spawn area";
+        }
+    }
+    const LevelWave *waves = SectionData(level, header->waves);
+    int total = 0;
+    for (uint32_t w = 0; w < header->waves.count; w++) {
+        if (waves[w].enemyCount < 0) return "negative wave size";
+        if (waves[w].enemyCount > LEVEL_MAX_WAVE_ENEMIES) return "wave too large";
+        if (!(waves[w].delay >= 0.0f) || !isfinite(waves[w].delay)) return "bad wave delay";
+        if (waves[w].enemyCount > 0 && header->spawns.count == 0) return "waves without spawn points";
+        // Each term is capped, so the sum is checked before it can overflow
+        if (waves[w].enemyCount > LEVEL_MAX_ENEMIES - total) return "too many enemies";
+        total += waves[w].enemyCount;
+    }
+    return NULL;
+}
+
+bool LoadLevel(Level *level, const char *path) {
+    memset(level, 0, sizeof(Level));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        TraceLog(LOG_WARNING, "LEVEL: Cannot open %s", path);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        TraceLog(LOG_WARNING, "LEVEL: Cannot read %s", path);
+        return false;
+    }
+
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (data == MAP_FAILED) {
+        TraceLog(LOG_WARNING, "LEVEL: Cannot map %s", path);
+        return false;
+    }
+
+    level->data = data;
+    level->size = (size_t)info.st_size;
+    level->header = data;
+    const char *error = ValidateLevel(level);
+    if (error) {
+        TraceLog(LOG_WARNING, "LEVEL: %s: %s", path, error);
+        UnloadLevel(level);
+        return false;
+    }
+
+    level->spawns = SectionData(level, level->header->spawns);
+    level->waves = SectionData(level, level->header->waves);
+    return true;
+}
+
+void UnloadLevel(Level *level) {
+    if (level->data) munmap(level->data, level->size);
+    memset(level, 0, sizeof(Level));
+}
+
+StaticWorld GetLevelWorld(const Level *level) {
+    const LevelHeader *header = level->header;
+    StaticWorld world = {0};
+    // The mapping is read-only; nothing writes to a built world, and UnloadStaticWorld
+    // leaves borrowed arrays alone
+    world.boxes = (WorldBox *)SectionData(level, header->boxes);
+    world.boxCount = (int)header->boxes.count;
+    world.trees = (Vector2 *)SectionData(level, header->trees);
+    world.treeCount = (int)header->trees.count;
+    world.halfSize = header->halfSize;
+    world.gridDim = header->gridDim;
+    world.chunkDim = header->chunkDim;
+    world.chunkBoxStart = (int *)SectionData(level, header->chunkBoxStart);
+    world.boxCellStart = (int *)SectionData(level, header->boxCellStart);
+    world.boxCellItems = (int *)SectionData(level, header->boxCellItems);
+    world.treeCellStart = (int *)SectionData(level, header->treeCellStart);
+    world.treeCellItems = (int *)SectionData(level, header->treeCellItems);
+    world.borrowed = true;
+    return world;
+}
+
+static void AdviseRange(const Level *level, const void *start, const void *end, bool resident) {
+    uintptr_t pageSize = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t first = (uintptr_t)start;
+    uintptr_t last = (uintptr_t)end;
+    uintptr_t mapEnd = (uintptr_t)level->data + level->size;
+    if (resident) {
+        // Whole pages around the range; reading a little of the neighbors costs nothing
+        first &= ~(pageSize - 1);
+        last = (last + pageSize - 1) & ~(pageSize - 1);
+        if (last > mapEnd) last = mapEnd;
+    } else {
+        // Only pages entirely inside the range, so a neighbor that stays resident keeps its data
+        first = (first + pageSize - 1) & ~(pageSize - 1);
+        last &= ~(pageSize - 1);
+    }
+    if (last > first) madvise((void *)first, last - first, resident ? MADV_WILLNEED : MADV_DONTNEED);
+}
+
+void SetLevelChunkResident(const Level *level, int chunk, bool resident) {
+    if (!level->data) return;
+    const LevelHeader *header = level->header;
+    const WorldBox *boxes = SectionData(level, header->boxes);
+    const int *chunkBoxStart = SectionData(level, header->chunkBoxStart);
+    AdviseRange(level, boxes + chunkBoxStart[chunk], boxes + chunkBoxStart[chunk + 1], resident);
+
+    // The chunk's cells are consecutive, and so are the items they list
+    int firstCell = chunk * WORLD_CHUNK_CELLS * WORLD_CHUNK_CELLS;
+    int endCell = firstCell + WORLD_CHUNK_CELLS * WORLD_CHUNK_CELLS;
+    LevelSection starts[2] = {header->boxCellStart, header->treeCellStart};
+    LevelSection items[2] = {header->boxCellItems, header->treeCellItems};
+    for (int k = 0; k < 2; k++) {
+        const int *cellStart = SectionData(level, starts[k]);
+        const int *cellItems = SectionData(level, items[k]);
+        AdviseRange(level, cellStart + firstCell, cellStart + endCell + 1, resident);
+        AdviseRange(level, cellItems + cellStart[firstCell], cellItems + cellStart[endCell], resident);
+    }
+}
+
+Rectangle GetLevelSpawnArea(LevelSpawn spawn) {
+    return (Rectangle){spawn.x - spawn.radius, spawn.z - spawn.radius, 2.0f * spawn.radius, 2.0f * spawn.radius};
+}
+
+int GetLevelEnemyCount(const Level *level) {
+    int count = 0;
+    for (uint32_t w = 0; w < level->header->waves.count; w++) count += level->waves[w].enemyCount;
+    return count;
+}
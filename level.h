@@ -0,0 +1,92 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include "world.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LEVEL_MAGIC 0x564c4646u  // "FFLV" little endian
+#define LEVEL_VERSION 2
+#define LEVEL_NAME_SIZE 32
+#define LEVEL_DIRECTORY "levels"
+#define LEVEL_EXTENSION ".lvl"
+#define LEVEL_MAX_WAVE_ENEMIES 10000  // Caps that keep enemy counts and their sums well inside an int
+#define LEVEL_MAX_ENEMIES 100000      // Over all waves
+
+// Compiled level file, produced by levelc from a text source. It is used in place: the
+// loader maps the file and points straight into it, so every section is stored exactly
+// as the structs below (little endian, 4-byte aligned) and nothing is copied or allocated.
+//
+//   header, then sections at the offsets it lists:
+//   boxes          WorldBox, trunks, foliage and walls, sorted by chunk
+//   trees          Vector2 trunk centers
+//   chunkBoxStart  int32 per chunk + 1, offsets into boxes
+//   boxCellStart   int32 per world grid cell + 1 (chunk by chunk), offsets into boxCellItems
+//   boxCellItems   int32 box indices (the StaticWorld grid, baked at WORLD_CELL_SIZE)
+//   treeCellStart  int32 per world grid cell + 1, offsets into treeCellItems
+//   treeCellItems  int32 tree indices
+//   spawns         LevelSpawn
+//   waves          LevelWave
+typedef struct {
+    uint32_t offset;  // Bytes from the start of the file
+    uint32_t count;   // Elements, not bytes
+} LevelSection;
+
+typedef struct {
+    float x;
+    float z;
+    float radius;  // Enemies appear anywhere in the square this far around (x, z)
+} LevelSpawn;
+
+typedef struct {
+    int32_t enemyCount;
+    float delay;  // Seconds after the previous wave is cleared (after the start, for the first)
+} LevelWave;
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    char name[LEVEL_NAME_SIZE];  // Shown in the level select, always NUL terminated
+    float halfSize;
+    float cellSize;              // Must match WORLD_CELL_SIZE
+    int32_t chunkCells;          // Must match WORLD_CHUNK_CELLS
+    int32_t gridDim;
+    int32_t chunkDim;
+    float playerStartX;
+    float playerStartZ;
+    LevelSection boxes;
+    LevelSection trees;
+    LevelSection chunkBoxStart;
+    LevelSection boxCellStart;
+    LevelSection boxCellItems;
+    LevelSection treeCellStart;
+    LevelSection treeCellItems;
+    LevelSection spawns;
+    LevelSection waves;
+} LevelHeader;
+
+// A mapped level file. Everything points into `data`, which stays mapped until UnloadLevel.
+typedef struct {
+    void *data;
+    size_t size;
+    const LevelHeader *header;
+    const LevelSpawn *spawns;
+    const LevelWave *waves;
+} Level;
+
+// Maps and validates a level file; logs why and returns false when it cannot be used
+bool LoadLevel(Level *level, const char *path);
+void UnloadLevel(Level *level);
+// The level's obstacles and grid as a StaticWorld that borrows the mapped arrays
+StaticWorld GetLevelWorld(const Level *level);
+// Paging hint for one chunk's boxes and grid cells: start reading them in the background,
+// or let the OS drop them. Either way reads stay correct, so this only changes residency.
+void SetLevelChunkResident(const Level *level, int chunk, bool resident);
+// Enemies over all waves, at most LEVEL_MAX_ENEMIES in a loaded level
+int GetLevelEnemyCount(const Level *level);
+// The square a spawn point's enemies appear in, on the XZ plane
+Rectangle GetLevelSpawnArea(LevelSpawn spawn);
+
+#endif
@@ -0,0 +1,254 @@
+// Level compiler: turns a text level source into the binary format LoadLevel maps.
+//
+//   levelc input.txt output.lvl
+//
+// One directive per line, '#' starts a comment. Positions are on the XZ plane.
+//
+//   name <text>                          Shown in the level select
+//   arena <halfSize>                     Arena spans [-halfSize, halfSize]; default 50
+//   player <x> <z>                       Player start; default 0 4
+//   walls                                Four walls around the arena, at its current size
+//   tree <x> <z> <height>                Trunk plus foliage, as AddWorldTree
+//   trees <x0> <z0> <cols> <rows> <gap>  Grid of trees, heights cycling 2, 3, 4; cells
+//                                        within 3 units of the player start stay open
+//   box <x0> <y0> <z0> <x1> <y1> <z1> <r> <g> <b>
+//   spawn <x> <z> <radius>               Enemy spawn area
+//   wave <enemies> <delay>               Next wave, `delay` seconds after the last is cleared
+//
+// The world grid is built here with the game's own BuildWorldGrid and stored with the
+// level, so loading it is only a matter of mapping the file. Every spawn area is filled
+// with the game's own spawner too, and the level is rejected if one cannot hold its wave.
+
+#include "level.h"
+#include "enemy.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LEVELC_MAX_LINE 256
+#define LEVELC_MAX_SPAWNS 256
+#define LEVELC_MAX_WAVES 256
+#define LEVELC_PLAYER_CLEARANCE 3.0f
+#define LEVELC_SPAWN_SEED 1
+
+typedef struct {
+    LevelHeader header;
+    StaticWorld world;
+    LevelSpawn spawns[LEVELC_MAX_SPAWNS];
+    int spawnCount;
+    LevelWave waves[LEVELC_MAX_WAVES];
+    int waveCount;
+} LevelSource;
+
+static void AddWalls(StaticWorld *world, float h) {
+    // North, east, west and south, 2 thick and 1 high, as in the built-in arena
+    AddWorldBox(world, (BoundingBox){{-h, 0.0f, -h - 1.0f}, {h, 1.0f, -h + 1.0f}}, DARKGRAY);
+    AddWorldBox(world, (BoundingBox){{h - 1.0f, 0.0f, -h}, {h + 1.0f, 1.0f, h}}, DARKGRAY);
+    AddWorldBox(world, (BoundingBox){{-h - 1.0f, 0.0f, -h}, {-h + 1.0f, 1.0f, h}}, DARKGRAY);
+    AddWorldBox(world, (BoundingBox){{-h, 0.0f, h - 1.0f}, {h, 1.0f, h + 1.0f}}, DARKGRAY);
+}
+
+static void AddTreeGrid(LevelSource *source, float x0, float z0, int cols, int rows, float gap) {
+    float px = source->header.playerStartX;
+    float pz = source->header.playerStartZ;
+    for (int i = 0; i < cols * rows; i++) {
+        float x = x0 + (i % cols) * gap;
+        float z = z0 + (i / cols) * gap;
+        if ((x - px) * (x - px) + (z - pz) * (z - pz) < LEVELC_PLAYER_CLEARANCE * LEVELC_PLAYER_CLEARANCE) continue;
+        AddWorldTree(&source->world, x, z, 2.0f + (i % 3));
+    }
+}
+
+// Returns an error message, or NULL when the line was understood
+static const char *ParseLine(LevelSource *source, char *line) {
+    char *comment = strchr(line, '#');
+    if (comment) *comment = '\0';
+
+    char keyword[16];
+    int consumed = 0;
+    if (sscanf(line, "%15s%n", keyword, &consumed) != 1) return NULL;  // Blank
+    const char *args = line + consumed;
+    LevelHeader *header = &source->header;
+    float f[9];
+    int n[2];
+
+    if (strcmp(keyword, "name") == 0) {
+        while (*args == ' ' || *args == '\t') args++;
+        size_t length = strcspn(args, "\r\n");
+        if (length == 0 || length >= LEVEL_NAME_SIZE) return "name must be 1 to 31 characters";
+        memset(header->name, 0, LEVEL_NAME_SIZE);
+        memcpy(header->name, args, length);
+    } else if (strcmp(keyword, "arena") == 0) {
+        if (sscanf(args, "%f", &f[0]) != 1 || !(f[0] > 0.0f)) return "expected arena <halfSize>";
+        header->halfSize = f[0];
+    } else if (strcmp(keyword, "player") == 0) {
+        if (sscanf(args, "%f %f", &f[0], &f[1]) != 2) return "expected player <x> <z>";
+        header->playerStartX = f[0];
+        header->playerStartZ = f[1];
+    } else if (strcmp(keyword, "walls") == 0) {
+        AddWalls(&source->world, header->halfSize);
+    } else if (strcmp(keyword, "tree") == 0) {
+        if (sscanf(args, "%f %f %f", &f[0], &f[1], &f[2]) != 3) return "expected tree <x> <z> <height>";
+        AddWorldTree(&source->world, f[0], f[1], f[2]);
+    } else if (strcmp(keyword, "trees") == 0) {
+        if (sscanf(args, "%f %f %d %d %f", &f[0], &f[1], &n[0], &n[1], &f[2]) != 5 || n[0] <= 0 || n[1] <= 0) {
+            return "expected trees <x0> <z0> <cols> <rows> <gap>";
+        }
+        AddTreeGrid(source, f[0], f[1], n[0], n[1], f[2]);
+    } else if (strcmp(keyword, "box") == 0) {
+        if (sscanf(args, "%f %f %f %f %f %f %f %f %f", &f[0], &f[1], &f[2], &f[3], &f[4], &f[5], &f[6], &f[7],
+                   &f[8]) != 9) {
+            return "expected box <x0> <y0> <z0> <x1> <y1> <z1> <r> <g> <b>";
+        }
+        Color color = {(unsigned char)f[6], (unsigned char)f[7], (unsigned char)f[8], 255};
+        AddWorldBox(&source->world, (BoundingBox){{fminf(f[0], f[3]), fminf(f[1], f[4]), fminf(f[2], f[5])},
+                                                  {fmaxf(f[0], f[3]), fmaxf(f[1], f[4]), fmaxf(f[2], f[5])}}, color);
+    } else if (strcmp(keyword, "spawn") == 0) {
+        if (sscanf(args, "%f %f %f", &f[0], &f[1], &f[2]) != 3 || !isfinite(f[0]) || !isfinite(f[1]) ||
+            !(f[2] >= 0.0f) || !isfinite(f[2])) {
+            return "expected spawn <x> <z> <radius>";
+        }
+        if (source->spawnCount == LEVELC_MAX_SPAWNS) return "too many spawn points";
+        source->spawns[source->spawnCount++] = (LevelSpawn){f[0], f[1], f[2]};
+    } else if (strcmp(keyword, "wave") == 0) {
+        if (sscanf(args, "%d %f", &n[0], &f[0]) != 2 || n[0] < 0 || !(f[0] >= 0.0f) || !isfinite(f[0])) {
+            return "expected wave <enemies> <delay>";
+        }
+        if (n[0] > LEVEL_MAX_WAVE_ENEMIES) return "wave larger than LEVEL_MAX_WAVE_ENEMIES";
+        if (source->waveCount == LEVELC_MAX_WAVES) return "too many waves";
+        source->waves[source->waveCount++] = (LevelWave){n[0], f[0]};
+    } else {
+        return "unknown directive";
+    }
+    return NULL;
+}
+
+// Fails when a spawn area has no room, under the spawner's rules, for the most enemies a
+// wave can deal it: SpawnWave gives each area enemyCount / spawnCount, rounded up for some.
+// Checked with the player at the start and from a fixed seed; a player standing close to an
+// area when a later wave spawns can still cut it short.
+static bool CheckSpawnRoom(LevelSource *source, const char *path) {
+    int share = 0;
+    for (int w = 0; w < source->waveCount; w++) {
+        int waveShare = (source->waves[w].enemyCount + source->spawnCount - 1) / source->spawnCount;
+        if (waveShare > share) share = waveShare;
+    }
+    if (share == 0) return true;
+
+    Vector3 player = {source->header.playerStartX, 0.0f, source->header.playerStartZ};
+    Vector2 *points = malloc(share * sizeof(Vector2));
+    bool fits = true;
+    for (int i = 0; i < source->spawnCount; i++) {
+        const LevelSpawn *spawn = &source->spawns[i];
+        SpawnArea area = GetEnemySpawnArea(GetLevelSpawnArea(*spawn), player);
+        uint32_t rng = SeedRandom(LEVELC_SPAWN_SEED);
+        int placed = PlaceSpawnPoints(&source->world, &area, share, &rng, points);
+        if (placed < share) {
+            fprintf(stderr, "%s: spawn %d at (%g, %g) has room for %d of the %d enemies a wave may send it\n", path,
+                    i + 1, spawn->x, spawn->z, placed, share);
+            fits = false;
+        }
+    }
+    free(points);
+    return fits;
+}
+
+// Appends one section, padded to 4 bytes, and records where it went
+static bool WriteSection(FILE *file, LevelSection *section, const void *data, uint32_t count, size_t elementSize) {
+    long offset = ftell(file);
+    static const unsigned char padding[4] = {0};
+    if (offset < 0 || fwrite(padding, 1, (size_t)(-offset & 3), file) != (size_t)(-offset & 3)) return false;
+
+    section->offset = (uint32_t)((offset + 3) & ~3L);
+    section->count = count;
+    return count == 0 || fwrite(data, elementSize, count, file) == count;
+}
+
+static bool WriteLevel(LevelSource *source, const char *path) {
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    StaticWorld *world = &source->world;
+    LevelHeader *header = &source->header;
+    uint32_t cellCount = (uint32_t)world->gridDim * (uint32_t)world->gridDim;
+    uint32_t chunkCount = (uint32_t)world->chunkDim * (uint32_t)world->chunkDim;
+    header->gridDim = world->gridDim;
+    header->chunkDim = world->chunkDim;
+
+    // Header first as a placeholder, then again once the section offsets are known
+    bool ok = fwrite(header, sizeof(LevelHeader), 1, file) == 1 &&
+              WriteSection(file, &header->boxes, world->boxes, world->boxCount, sizeof(WorldBox)) &&
+              WriteSection(file, &header->trees, world->trees, world->treeCount, sizeof(Vector2)) &&
+              WriteSection(file, &header->chunkBoxStart, world->chunkBoxStart, chunkCount + 1, sizeof(int)) &&
+              WriteSection(file, &header->boxCellStart, world->boxCellStart, cellCount + 1, sizeof(int)) &&
+              WriteSection(file, &header->boxCellItems, world->boxCellItems, world->boxCellStart[cellCount], sizeof(int)) &&
+              WriteSection(file, &header->treeCellStart, world->treeCellStart, cellCount + 1, sizeof(int)) &&
+              WriteSection(file, &header->treeCellItems, world->treeCellItems, world->treeCount, sizeof(int)) &&
+              WriteSection(file, &header->spawns, source->spawns, source->spawnCount, sizeof(LevelSpawn)) &&
+              WriteSection(file, &header->waves, source->waves, source->waveCount, sizeof(LevelWave)) &&
+              fseek(file, 0, SEEK_SET) == 0 &&
+              fwrite(header, sizeof(LevelHeader), 1, file) == 1;
+    return fclose(file) == 0 && ok;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: levelc input.txt output.lvl\n");
+        return 1;
+    }
+
+    FILE *input = fopen(argv[1], "r");
+    if (!input) {
+        fprintf(stderr, "%s: cannot open\n", argv[1]);
+        return 1;
+    }
+
+    static LevelSource source;
+    source.header.magic = LEVEL_MAGIC;
+    source.header.version = LEVEL_VERSION;
+    source.header.headerSize = sizeof(LevelHeader);
+    source.header.halfSize = ARENA_HALF_SIZE;
+    source.header.cellSize = WORLD_CELL_SIZE;
+    source.header.chunkCells = WORLD_CHUNK_CELLS;
+    source.header.playerStartZ = 4.0f;
+    snprintf(source.header.name, LEVEL_NAME_SIZE, "Untitled");
+
+    char line[LEVELC_MAX_LINE];
+    int lineNumber = 0;
+    bool failed = false;
+    while (fgets(line, sizeof(line), input)) {
+        lineNumber++;
+        const char *error = ParseLine(&source, line);
+        if (error) {
+            fprintf(stderr, "%s:%d: %s\n", argv[1], lineNumber, error);
+            failed = true;
+        }
+    }
+    fclose(input);
+    if (failed) return 1;
+
+    int enemyCount = 0;
+    for (int w = 0; w < source.waveCount; w++) enemyCount += source.waves[w].enemyCount;
+    if (enemyCount > 0 && source.spawnCount == 0) {
+        fprintf(stderr, "%s: waves need at least one spawn point\n", argv[1]);
+        return 1;
+    }
+    if (enemyCount > LEVEL_MAX_ENEMIES) {
+        fprintf(stderr, "%s: %d enemies, more than LEVEL_MAX_ENEMIES (%d)\n", argv[1], enemyCount, LEVEL_MAX_ENEMIES);
+        return 1;
+    }
+
+    source.world.halfSize = source.header.halfSize;
+    BuildWorldGrid(&source.world);
+    if (source.spawnCount > 0 && !CheckSpawnRoom(&source, argv[1])) return 1;
+    if (!WriteLevel(&source, argv[2])) {
+        fprintf(stderr, "%s: cannot write\n", argv[2]);
+        return 1;
+    }
+
+    printf("%s: \"%s\", %d boxes, %d trees, %d spawns, %d waves, %d enemies\n", argv[2], source.header.name,
+           source.world.boxCount, source.world.treeCount, source.spawnCount, source.waveCount, enemyCount);
+    UnloadStaticWorld(&source.world);
+    return 0;
+}
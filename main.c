@@ -1,25 +1,82 @@
 #include "game.h"
+#include "jobs.h"
+#include "profiler.h"
 #include "raylib.h"
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int main() {
+// Replays a recording with no window or audio and reports how long the simulation took
+static int RunFastReplay(const char *path) {
+  ReplayResult result;
+  if (!RunReplayHeadless(path, &result)) {
+    fprintf(stderr, "Could not read replay %s\n", path);
+    return 1;
+  }
+
+  bool match = result.checksum == result.expected;
+  printf("frames %u, sim %.3f ms (%.4f ms/frame), checksum %08x, recorded %08x: %s\n", result.frames,
+         result.seconds * 1000.0, result.frames > 0 ? result.seconds * 1000.0 / result.frames : 0.0,
+         result.checksum, result.expected, match ? "match" : "MISMATCH");
+  return match ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
   const int screenWidth = 1920;
   const int screenHeight = 1080;
+  const int targetFPS = 60;
+
+  ReplayMode replayMode = REPLAY_MODE_NONE;
+  const char *replayPath = NULL;
+  // The 3D pass drops toward the minimum scale when frames miss the target rate
+  float minRenderScale = RENDER_SCALE_MIN_DEFAULT;
+  float maxRenderScale = RENDER_SCALE_MAX_DEFAULT;
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--record") == 0) {
+      replayMode = REPLAY_MODE_RECORD;
+      replayPath = argv[++i];
+    } else if (strcmp(argv[i], "--replay") == 0) {
+      replayMode = REPLAY_MODE_PLAYBACK;
+      replayPath = argv[++i];
+    } else if (strcmp(argv[i], "--min-render-scale") == 0) {
+      minRenderScale = strtof(argv[++i], NULL);
+    } else if (strcmp(argv[i], "--max-render-scale") == 0) {
+      maxRenderScale = strtof(argv[++i], NULL);
+    } else if (strcmp(argv[i], "--replay-fast") == 0) {
+      InitJobSystem(0);
+      int status = RunFastReplay(argv[i + 1]);
+      ShutdownJobSystem();
+      return status;
+    }
+  }
+
+  // One worker per spare core for the enemy update and collision passes
+  InitJobSystem(0);
 
   InitWindow(screenWidth, screenHeight, "Frisbee Takedown");
   InitAudioDevice();
-  SetTargetFPS(60);
+  SetTargetFPS(targetFPS);
 
-  Game game = InitGame();
+  ProfileSetThreadName("Main");
+  static Game game;
+  InitGame(&game);
+  SetGameReplay(&game, replayMode, replayPath);
+  SetGameRenderScale(&game, minRenderScale, maxRenderScale, 1.0f / targetFPS);
 
+  // The simulation ticks at a fixed rate on its own thread while a level plays; each frame
+  // draws the newest tick it has finished, blended toward the one before.
   while (!WindowShouldClose()) {
     UpdateMusicStream(game.backgroundMusic);
     UpdateGame(&game);
     DrawGame(&game);
+    PROFILE_FRAME();
   }
 
-  UnloadGameAudio(&game);
+  UnloadGame(&game);
   CloseAudioDevice();
   CloseWindow();
+  ShutdownJobSystem();
 
   return 0;
 }
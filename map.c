@@ -1,20 +1,264 @@
 #include "map.h"
+#include "raymath.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
-void DrawMap(void) {
-    DrawPlane((Vector3){0.0f, 0.0f, 0.0f}, (Vector2){200.0f, 200.0f}, DARKGREEN);
-    DrawPlane((Vector3){0.0f, 0.01f, 0.0f}, (Vector2){80.0f, 80.0f}, GREEN);
-    DrawPlane((Vector3){0.0f, 0.02f, 0.0f}, (Vector2){30.0f, 30.0f}, LIME);
+// Ground bands around the arena center: a 30x30 lime square, grass out to 40 and dark
+// grass beyond. Chunk ground is cut at the band edges so every piece has one color.
+static const float GROUND_CUTS[4] = {-40.0f, -15.0f, 15.0f, 40.0f};
 
-    for (int i = 0; i < 20; i++) {
-        float x = (i % 5) * 15.0f - 30.0f;
-        float z = (i / 5) * 15.0f - 30.0f;
-        float height = 2.0f + (i % 3);
-        DrawCube((Vector3){x, height / 2.0f, z}, 1.0f, height, 1.0f, BROWN);
-        DrawCube((Vector3){x, height + 1.5f, z}, 3.0f, 3.0f, 3.0f, DARKGREEN);
+static Color GetGroundColor(float x, float z) {
+    float d = fmaxf(fabsf(x), fabsf(z));
+    if (d < 15.0f) return LIME;
+    if (d < 40.0f) return GREEN;
+    return DARKGREEN;
+}
+
+// Writes min, every cut strictly between min and max, then max. Returns how many.
+static int SplitGroundSpan(float min, float max, float *out) {
+    int count = 0;
+    out[count++] = min;
+    for (int i = 0; i < 4; i++) {
+        if (GROUND_CUTS[i] > min && GROUND_CUTS[i] < max) out[count++] = GROUND_CUTS[i];
+    }
+    out[count++] = max;
+    return count;
+}
+
+static int GetChunkDistance(const StaticWorld *world, int a, int b) {
+    int dx = abs(a % world->chunkDim - b % world->chunkDim);
+    int dz = abs(a / world->chunkDim - b / world->chunkDim);
+    return dx > dz ? dx : dz;
+}
+
+// Ground and boxes of one chunk. Reads only the world, so it is safe on the worker.
+static BoundingBox BuildArenaChunk(const StaticWorld *world, int chunk, MeshBuilder *builder) {
+    int chunkX = chunk % world->chunkDim;
+    int chunkZ = chunk / world->chunkDim;
+    Rectangle rect = GetWorldChunkBounds(world, chunkX, chunkZ);
+    float minX = rect.x, maxX = rect.x + rect.width;
+    float minZ = rect.y, maxZ = rect.y + rect.height;
+    if (chunkX == 0) minX -= ARENA_GROUND_MARGIN;
+    if (chunkX == world->chunkDim - 1) maxX += ARENA_GROUND_MARGIN;
+    if (chunkZ == 0) minZ -= ARENA_GROUND_MARGIN;
+    if (chunkZ == world->chunkDim - 1) maxZ += ARENA_GROUND_MARGIN;
+
+    float xs[6], zs[6];
+    int xCount = SplitGroundSpan(minX, maxX, xs);
+    int zCount = SplitGroundSpan(minZ, maxZ, zs);
+    for (int j = 0; j + 1 < zCount; j++) {
+        for (int i = 0; i + 1 < xCount; i++) {
+            Color color = GetGroundColor((xs[i] + xs[i + 1]) / 2.0f, (zs[j] + zs[j + 1]) / 2.0f);
+            AppendMeshGroundRect(builder, xs[i], zs[j], xs[i + 1], zs[j + 1], 0.0f, color);
+        }
+    }
+
+    // Boxes are stored chunk by chunk, so this chunk's are one range
+    BoundingBox bounds = {{minX, 0.0f, minZ}, {maxX, 0.0f, maxZ}};
+    for (int i = world->chunkBoxStart[chunk]; i < world->chunkBoxStart[chunk + 1]; i++) {
+        BoundingBox b = world->boxes[i].box;
+        Vector3 center = {(b.min.x + b.max.x) / 2.0f, (b.min.y + b.max.y) / 2.0f, (b.min.z + b.max.z) / 2.0f};
+        Vector3 size = {b.max.x - b.min.x, b.max.y - b.min.y, b.max.z - b.min.z};
+        AppendMeshBox(builder, center, size, world->boxes[i].color, (Vector2){0});
+        bounds.min = Vector3Min(bounds.min, b.min);
+        bounds.max = Vector3Max(bounds.max, b.max);
+    }
+    return bounds;
+}
+
+static void SetChunkBounds(ArenaChunk *chunk, BoundingBox bounds) {
+    chunk->center = Vector3Scale(Vector3Add(bounds.min, bounds.max), 0.5f);
+    chunk->radius = Vector3Distance(bounds.min, bounds.max) / 2.0f;
+}
+
+// Called and returns with the lock held; the build itself runs unlocked. Returns false
+// when nothing is queued.
+static bool BuildQueuedChunk(ArenaMap *arena) {
+    if (arena->queueHead == arena->queueCount) return false;
+
+    int c = arena->queue[arena->queueHead++];
+    ArenaChunk *chunk = &arena->chunks[c];
+    chunk->state = ARENA_CHUNK_BUILDING;
+    pthread_mutex_unlock(&arena->lock);
+
+    MeshBuilder builder = {0};
+    BoundingBox bounds = BuildArenaChunk(arena->world, c, &builder);
+
+    pthread_mutex_lock(&arena->lock);
+    chunk->builder = builder;
+    SetChunkBounds(chunk, bounds);
+    chunk->state = ARENA_CHUNK_BUILT;
+    arena->completed[arena->completedCount++] = c;
+    return true;
+}
+
+static void *ArenaWorker(void *context) {
+    ArenaMap *arena = context;
+
+    pthread_mutex_lock(&arena->lock);
+    while (!arena->cancel) {
+        if (!BuildQueuedChunk(arena)) pthread_cond_wait(&arena->wake, &arena->lock);
+    }
+    pthread_mutex_unlock(&arena->lock);
+    return NULL;
+}
+
+static int GetFocusChunk(const StaticWorld *world, Vector3 focus) {
+    return GetWorldChunkCoord(world, focus.z) * world->chunkDim + GetWorldChunkCoord(world, focus.x);
+}
+
+// Re-plans around a new focus chunk: unloads what drifted out of range and queues what
+// came into it, ring by ring outward so the nearest chunks are built first
+static void PlanArenaChunks(ArenaMap *arena, int focusChunk) {
+    const StaticWorld *world = arena->world;
+    int chunkCount = world->chunkDim * world->chunkDim;
+    arena->focusChunk = focusChunk;
+
+    pthread_mutex_lock(&arena->lock);
+    for (int c = 0; c < chunkCount; c++) {
+        ArenaChunk *chunk = &arena->chunks[c];
+        bool keep = GetChunkDistance(world, c, focusChunk) <= WORLD_STREAM_RADIUS + 1;
+        if (chunk->state == ARENA_CHUNK_QUEUED) {
+            chunk->state = ARENA_CHUNK_UNLOADED;  // Queued again below if still in range
+        } else if (chunk->state == ARENA_CHUNK_BUILDING || chunk->state == ARENA_CHUNK_BUILT) {
+            chunk->wanted = keep;
+        } else if (chunk->state == ARENA_CHUNK_RESIDENT && !keep) {
+            UnloadMesh(chunk->mesh);
+            chunk->mesh = (Mesh){0};
+            chunk->state = ARENA_CHUNK_UNLOADED;
+            arena->residentCount--;
+        }
+    }
+
+    arena->queueHead = 0;
+    arena->queueCount = 0;
+    int focusX = focusChunk % world->chunkDim;
+    int focusZ = focusChunk / world->chunkDim;
+    for (int ring = 0; ring <= WORLD_STREAM_RADIUS; ring++) {
+        for (int cz = focusZ - ring; cz <= focusZ + ring; cz++) {
+            for (int cx = focusX - ring; cx <= focusX + ring; cx++) {
+                if (cx < 0 || cz < 0 || cx >= world->chunkDim || cz >= world->chunkDim) continue;
+                if (abs(cx - focusX) != ring && abs(cz - focusZ) != ring) continue;  // Inner ring
+
+                int c = cz * world->chunkDim + cx;
+                if (arena->chunks[c].state != ARENA_CHUNK_UNLOADED) continue;
+                arena->chunks[c].state = ARENA_CHUNK_QUEUED;
+                arena->chunks[c].wanted = true;
+                arena->queue[arena->queueCount++] = c;
+            }
+        }
+    }
+    pthread_cond_signal(&arena->wake);
+    pthread_mutex_unlock(&arena->lock);
+}
+
+void LoadArenaMap(ArenaMap *arena, const StaticWorld *world, Vector3 focus) {
+    memset(arena, 0, sizeof(ArenaMap));
+    int chunkCount = world->chunkDim * world->chunkDim;
+    arena->world = world;
+    arena->chunks = calloc(chunkCount, sizeof(ArenaChunk));
+    arena->queue = malloc(chunkCount * sizeof(int));
+    arena->completed = malloc(chunkCount * sizeof(int));
+    arena->material = LoadMaterialDefault();
+    pthread_mutex_init(&arena->lock, NULL);
+    pthread_cond_init(&arena->wake, NULL);
+
+    // Whatever the player sees first is built right away, as part of loading the level
+    arena->focusChunk = GetFocusChunk(world, focus);
+    for (int c = 0; c < chunkCount; c++) {
+        if (GetChunkDistance(world, c, arena->focusChunk) > WORLD_STREAM_RADIUS) continue;
+        ArenaChunk *chunk = &arena->chunks[c];
+        SetChunkBounds(chunk, BuildArenaChunk(world, c, &chunk->builder));
+        chunk->mesh = FinishMesh(&chunk->builder);
+        chunk->state = ARENA_CHUNK_RESIDENT;
+        chunk->wanted = true;
+        arena->residentCount++;
+    }
+
+    if (pthread_create(&arena->worker, NULL, ArenaWorker, arena) == 0) {
+        arena->started = true;
+    } else {
+        TraceLog(LOG_WARNING, "MAP: Failed to start chunk builder thread, building on the main thread");
+    }
+}
+
+void UpdateArenaMap(ArenaMap *arena, Vector3 focus) {
+    int focusChunk = GetFocusChunk(arena->world, focus);
+    if (focusChunk != arena->focusChunk) PlanArenaChunks(arena, focusChunk);
+
+    int taken[ARENA_UPLOADS_PER_FRAME];
+    int takenCount = 0;
+    pthread_mutex_lock(&arena->lock);
+    if (!arena->started) {
+        while (BuildQueuedChunk(arena)) {}
+    }
+    while (takenCount < ARENA_UPLOADS_PER_FRAME && takenCount < arena->completedCount) {
+        int c = arena->completed[takenCount];
+        ArenaChunk *chunk = &arena->chunks[c];
+        chunk->state = chunk->wanted ? ARENA_CHUNK_RESIDENT : ARENA_CHUNK_UNLOADED;
+        taken[takenCount++] = c;
     }
+    arena->completedCount -= takenCount;
+    memmove(arena->completed, arena->completed + takenCount, arena->completedCount * sizeof(int));
+    arena->pendingCount = arena->queueCount - arena->queueHead + arena->completedCount;
+    pthread_mutex_unlock(&arena->lock);
 
-    DrawCube((Vector3){0.0f, 0.5f, -50.0f}, 100.0f, 1.0f, 2.0f, DARKGRAY);
-    DrawCube((Vector3){50.0f, 0.5f, 0.0f}, 2.0f, 1.0f, 100.0f, DARKGRAY);
-    DrawCube((Vector3){-50.0f, 0.5f, 0.0f}, 2.0f, 1.0f, 100.0f, DARKGRAY);
-    DrawCube((Vector3){0.0f, 0.5f, 50.0f}, 100.0f, 1.0f, 2.0f, DARKGRAY);
+    // GPU uploads stay on this thread, a few per frame so a burst of new chunks never stalls one
+    for (int i = 0; i < takenCount; i++) {
+        ArenaChunk *chunk = &arena->chunks[taken[i]];
+        if (chunk->state == ARENA_CHUNK_RESIDENT) {
+            chunk->mesh = FinishMesh(&chunk->builder);
+            arena->residentCount++;
+        } else {
+            UnloadMeshBuilder(&chunk->builder);
+        }
+    }
+    arena->uploadCount = takenCount;
+}
+
+void UnloadArenaMap(ArenaMap *arena) {
+    if (!arena->chunks) return;
+
+    if (arena->started) {
+        pthread_mutex_lock(&arena->lock);
+        arena->cancel = true;
+        pthread_cond_signal(&arena->wake);
+        pthread_mutex_unlock(&arena->lock);
+        pthread_join(arena->worker, NULL);
+    }
+
+    int chunkCount = arena->world->chunkDim * arena->world->chunkDim;
+    for (int c = 0; c < chunkCount; c++) {
+        ArenaChunk *chunk = &arena->chunks[c];
+        if (chunk->state == ARENA_CHUNK_RESIDENT) UnloadMesh(chunk->mesh);
+        if (chunk->state == ARENA_CHUNK_BUILT) UnloadMeshBuilder(&chunk->builder);
+    }
+    UnloadMaterial(arena->material);
+    pthread_cond_destroy(&arena->wake);
+    pthread_mutex_destroy(&arena->lock);
+    free(arena->chunks);
+    free(arena->queue);
+    free(arena->completed);
+    memset(arena, 0, sizeof(ArenaMap));
+}
+
+void DrawMap(const ArenaMap *arena, const Frustum *frustum, CullStats *stats) {
+    const StaticWorld *world = arena->world;
+    int focusX = arena->focusChunk % world->chunkDim;
+    int focusZ = arena->focusChunk / world->chunkDim;
+    int reach = WORLD_STREAM_RADIUS + 1;  // Resident chunks never lie further out
+    for (int cz = focusZ - reach; cz <= focusZ + reach; cz++) {
+        for (int cx = focusX - reach; cx <= focusX + reach; cx++) {
+            if (cx < 0 || cz < 0 || cx >= world->chunkDim || cz >= world->chunkDim) continue;
+            // The mesh is only touched on this thread; state may be changing under the lock
+            const ArenaChunk *chunk = &arena->chunks[cz * world->chunkDim + cx];
+            if (chunk->mesh.vertexCount == 0) continue;
+
+            stats->considered++;
+            if (!IsSphereInFrustum(frustum, chunk->center, chunk->radius)) continue;
+            stats->drawn++;
+            DrawMesh(chunk->mesh, arena->material, MatrixIdentity());
+        }
+    }
 }
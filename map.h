@@ -2,7 +2,63 @@
 #define MAP_H
 
 #include "raylib.h"
+#include "world.h"
+#include "frustum.h"
+#include "mesh_builder.h"
+#include <pthread.h>
+#include <stdbool.h>
 
-void DrawMap(void);
+#define ARENA_GROUND_MARGIN 50.0f  // Ground reaching past the walls on the world's edge chunks
+#define ARENA_UPLOADS_PER_FRAME 2  // Finished chunk meshes handed to the GPU per UpdateArenaMap
+
+typedef enum {
+    ARENA_CHUNK_UNLOADED,
+    ARENA_CHUNK_QUEUED,    // Waiting for the worker
+    ARENA_CHUNK_BUILDING,  // Worker is filling the builder
+    ARENA_CHUNK_BUILT,     // Geometry ready, waiting in the completion queue for upload
+    ARENA_CHUNK_RESIDENT   // Mesh uploaded and drawn
+} ArenaChunkState;
+
+typedef struct {
+    ArenaChunkState state;  // Guarded by the map's lock
+    bool wanted;            // Still in range; a build that finishes unwanted is thrown away
+    MeshBuilder builder;    // Worker output, owned by whoever holds the chunk's current state
+    Mesh mesh;
+    Vector3 center;         // Bounding sphere for culling
+    float radius;
+} ArenaChunk;
+
+// The static arena as one vertex-colored mesh per world chunk: ground plus the chunk's
+// trees and walls. Only chunks within WORLD_STREAM_RADIUS of the player are kept. Their
+// geometry is built on a background thread, nearest first, and uploaded a few per frame;
+// chunks more than one chunk beyond the radius are unloaded, so walking back and forth
+// over a border does not rebuild anything.
+//
+// Initialized in place, since the worker holds a pointer to it. The world must outlive the map.
+typedef struct {
+    const StaticWorld *world;
+    ArenaChunk *chunks;    // One per world chunk
+    Material material;
+    int *queue;            // Requested chunks, nearest to the focus first; guarded by lock
+    int queueHead;
+    int queueCount;
+    int *completed;        // Completion queue: chunks the worker finished, in order; guarded by lock
+    int completedCount;
+    bool cancel;           // Guarded by lock
+    pthread_mutex_t lock;
+    pthread_cond_t wake;   // Signals the worker that the queue changed or it should stop
+    pthread_t worker;
+    bool started;
+    int focusChunk;        // Chunk the requests were planned around
+    int residentCount;     // Stats for the profiler overlay
+    int pendingCount;
+    int uploadCount;       // Uploads in the last UpdateArenaMap
+} ArenaMap;
+
+// Builds the chunks around `focus` right away, then streams the rest as the focus moves
+void LoadArenaMap(ArenaMap *arena, const StaticWorld *world, Vector3 focus);
+void UpdateArenaMap(ArenaMap *arena, Vector3 focus);
+void UnloadArenaMap(ArenaMap *arena);
+void DrawMap(const ArenaMap *arena, const Frustum *frustum, CullStats *stats);
 
 #endif
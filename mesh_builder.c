@@ -0,0 +1,108 @@
+#include "mesh_builder.h"
+#include <stdlib.h>
+
+// Box faces as outward normal plus four corner signs, counter-clockwise seen from outside
+static const float BOX_FACES[6][5][3] = {
+    {{1, 0, 0}, {1, -1, 1}, {1, -1, -1}, {1, 1, -1}, {1, 1, 1}},
+    {{-1, 0, 0}, {-1, -1, -1}, {-1, -1, 1}, {-1, 1, 1}, {-1, 1, -1}},
+    {{0, 1, 0}, {-1, 1, 1}, {1, 1, 1}, {1, 1, -1}, {-1, 1, -1}},
+    {{0, -1, 0}, {-1, -1, -1}, {1, -1, -1}, {1, -1, 1}, {-1, -1, 1}},
+    {{0, 0, 1}, {-1, -1, 1}, {1, -1, 1}, {1, 1, 1}, {-1, 1, 1}},
+    {{0, 0, -1}, {1, -1, -1}, {-1, -1, -1}, {-1, 1, -1}, {1, 1, -1}}
+};
+
+static void ReserveVertices(MeshBuilder *builder, int extra) {
+    int needed = builder->vertexCount + extra;
+    if (needed <= builder->capacity) return;
+
+    int capacity = builder->capacity > 0 ? builder->capacity : 256;
+    while (capacity < needed) capacity *= 2;
+
+    builder->vertices = realloc(builder->vertices, capacity * 3 * sizeof(float));
+    builder->texcoords = realloc(builder->texcoords, capacity * 2 * sizeof(float));
+    builder->texcoords2 = realloc(builder->texcoords2, capacity * 2 * sizeof(float));
+    builder->normals = realloc(builder->normals, capacity * 3 * sizeof(float));
+    builder->colors = realloc(builder->colors, capacity * 4 * sizeof(unsigned char));
+    builder->capacity = capacity;
+}
+
+static void AppendVertex(MeshBuilder *builder, Vector3 position, Vector3 normal, Color color, Vector2 attribute) {
+    int v = builder->vertexCount++;
+    builder->vertices[v * 3 + 0] = position.x;
+    builder->vertices[v * 3 + 1] = position.y;
+    builder->vertices[v * 3 + 2] = position.z;
+    builder->texcoords[v * 2 + 0] = 0.0f;
+    builder->texcoords[v * 2 + 1] = 0.0f;
+    builder->texcoords2[v * 2 + 0] = attribute.x;
+    builder->texcoords2[v * 2 + 1] = attribute.y;
+    builder->normals[v * 3 + 0] = normal.x;
+    builder->normals[v * 3 + 1] = normal.y;
+    builder->normals[v * 3 + 2] = normal.z;
+    builder->colors[v * 4 + 0] = color.r;
+    builder->colors[v * 4 + 1] = color.g;
+    builder->colors[v * 4 + 2] = color.b;
+    builder->colors[v * 4 + 3] = color.a;
+}
+
+void AppendMeshBox(MeshBuilder *builder, Vector3 center, Vector3 size, Color color, Vector2 attribute) {
+    ReserveVertices(builder, 36);
+
+    for (int f = 0; f < 6; f++) {
+        Vector3 normal = {BOX_FACES[f][0][0], BOX_FACES[f][0][1], BOX_FACES[f][0][2]};
+        Vector3 corners[4];
+        for (int c = 0; c < 4; c++) {
+            corners[c] = (Vector3){
+                center.x + BOX_FACES[f][c + 1][0] * size.x / 2.0f,
+                center.y + BOX_FACES[f][c + 1][1] * size.y / 2.0f,
+                center.z + BOX_FACES[f][c + 1][2] * size.z / 2.0f
+            };
+        }
+
+        // Two triangles per face: (0, 1, 2) and (0, 2, 3)
+        AppendVertex(builder, corners[0], normal, color, attribute);
+        AppendVertex(builder, corners[1], normal, color, attribute);
+        AppendVertex(builder, corners[2], normal, color, attribute);
+        AppendVertex(builder, corners[0], normal, color, attribute);
+        AppendVertex(builder, corners[2], normal, color, attribute);
+        AppendVertex(builder, corners[3], normal, color, attribute);
+    }
+}
+
+void AppendMeshGroundRect(MeshBuilder *builder, float minX, float minZ, float maxX, float maxZ, float y, Color color) {
+    ReserveVertices(builder, 6);
+
+    Vector3 up = {0.0f, 1.0f, 0.0f};
+    Vector3 corners[4] = {
+        {minX, y, maxZ}, {maxX, y, maxZ}, {maxX, y, minZ}, {minX, y, minZ}
+    };
+    AppendVertex(builder, corners[0], up, color, (Vector2){0});
+    AppendVertex(builder, corners[1], up, color, (Vector2){0});
+    AppendVertex(builder, corners[2], up, color, (Vector2){0});
+    AppendVertex(builder, corners[0], up, color, (Vector2){0});
+    AppendVertex(builder, corners[2], up, color, (Vector2){0});
+    AppendVertex(builder, corners[3], up, color, (Vector2){0});
+}
+
+Mesh FinishMesh(MeshBuilder *builder) {
+    Mesh mesh = {0};
+    mesh.vertexCount = builder->vertexCount;
+    mesh.triangleCount = builder->vertexCount / 3;
+    mesh.vertices = builder->vertices;
+    mesh.texcoords = builder->texcoords;
+    mesh.texcoords2 = builder->texcoords2;
+    mesh.normals = builder->normals;
+    mesh.colors = builder->colors;
+    UploadMesh(&mesh, false);
+
+    *builder = (MeshBuilder){0};
+    return mesh;
+}
+
+void UnloadMeshBuilder(MeshBuilder *builder) {
+    free(builder->vertices);
+    free(builder->texcoords);
+    free(builder->texcoords2);
+    free(builder->normals);
+    free(builder->colors);
+    *builder = (MeshBuilder){0};
+}
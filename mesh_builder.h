@@ -0,0 +1,27 @@
+#ifndef MESH_BUILDER_H
+#define MESH_BUILDER_H
+
+#include "raylib.h"
+
+// Accumulates flat-shaded, vertex-colored triangles on the CPU, then hands the
+// arrays to a raylib Mesh and uploads it once
+typedef struct {
+    float *vertices;
+    float *texcoords;
+    float *texcoords2;  // Free per-vertex attribute for custom shaders
+    float *normals;
+    unsigned char *colors;
+    int vertexCount;
+    int capacity;
+} MeshBuilder;
+
+// Appends an axis-aligned box as 12 triangles
+void AppendMeshBox(MeshBuilder *builder, Vector3 center, Vector3 size, Color color, Vector2 attribute);
+// Appends an upward-facing rectangle on the XZ plane at height y
+void AppendMeshGroundRect(MeshBuilder *builder, float minX, float minZ, float maxX, float maxZ, float y, Color color);
+// Uploads the accumulated geometry; the Mesh takes ownership of the builder's arrays
+Mesh FinishMesh(MeshBuilder *builder);
+// Frees geometry that will not be uploaded after all
+void UnloadMeshBuilder(MeshBuilder *builder);
+
+#endif
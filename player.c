@@ -1,6 +1,5 @@
 #include "player.h"
 #include "raymath.h"
-#include "rlgl.h"
 #include <math.h>
 
 #define PLAYER_HEIGHT 2.0f
@@ -22,19 +21,17 @@ Player InitPlayer(void) {
     player.isThrowing = false;
     player.chargeTime = 0.0f;
     player.isCharging = false;
+    player.fireCooldown = 0.0f;
     player.health = PLAYER_MAX_HEALTH;
     player.maxHealth = PLAYER_MAX_HEALTH;
     player.damageFlash = 0.0f;
     return player;
 }
 
-void UpdatePlayer(Player *player, Camera *camera) {
-    float dt = GetFrameTime();
-
+void UpdatePlayer(Player *player, Camera *camera, const PlayerInput *input, float dt) {
     // Mouse look
-    Vector2 mouseDelta = GetMouseDelta();
-    player->yaw += mouseDelta.x * MOUSE_SENSITIVITY;
-    player->pitch -= mouseDelta.y * MOUSE_SENSITIVITY;
+    player->yaw += input->lookDelta.x * MOUSE_SENSITIVITY;
+    player->pitch -= input->lookDelta.y * MOUSE_SENSITIVITY;
 
     // Clamp pitch to prevent flipping
     if (player->pitch > 89.0f * DEG2RAD) player->pitch = 89.0f * DEG2RAD;
@@ -54,19 +51,19 @@ void UpdatePlayer(Player *player, Camera *camera) {
 
     // Movement input
     Vector3 moveDir = {0};
-    if (IsKeyDown(KEY_W)) {
+    if (input->moveForward) {
         moveDir.x += forward.x;
         moveDir.z += forward.z;
     }
-    if (IsKeyDown(KEY_S)) {
+    if (input->moveBack) {
         moveDir.x -= forward.x;
         moveDir.z -= forward.z;
     }
-    if (IsKeyDown(KEY_D)) {
+    if (input->moveRight) {
         moveDir.x += right.x;
         moveDir.z += right.z;
     }
-    if (IsKeyDown(KEY_A)) {
+    if (input->moveLeft) {
         moveDir.x -= right.x;
         moveDir.z -= right.z;
     }
@@ -79,14 +76,14 @@ void UpdatePlayer(Player *player, Camera *camera) {
     }
 
     // Sprint
-    float speed = IsKeyDown(KEY_LEFT_SHIFT) ? SPRINT_SPEED : WALK_SPEED;
+    float speed = input->sprint ? SPRINT_SPEED : WALK_SPEED;
 
     // Apply horizontal movement
     player->position.x += moveDir.x * speed * dt;
     player->position.z += moveDir.z * speed * dt;
 
     // Jump
-    if (IsKeyPressed(KEY_SPACE) && player->isGrounded) {
+    if (input->jump && player->isGrounded) {
         player->velocityY = JUMP_FORCE;
         player->isGrounded = false;
     }
@@ -117,39 +114,3 @@ void UpdatePlayer(Player *player, Camera *camera) {
         camera->position.z + lookDir.z
     };
 }
-
-void DrawPlayerHand(Camera camera, float throwProgress, float chargeProgress) {
-    // Get camera's forward and right vectors
-    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
-    Vector3 right = Vector3CrossProduct(forward, camera.up);
-
-    // Arm position: offset right, down, and forward from camera
-    Vector3 armPos = camera.position;
-    armPos = Vector3Add(armPos, Vector3Scale(right, 0.4f));       // right
-    armPos = Vector3Add(armPos, Vector3Scale(camera.up, -0.3f));  // down
-    armPos = Vector3Add(armPos, Vector3Scale(forward, 0.6f));     // forward
-
-    // Calculate yaw angle from camera forward direction
-    float yawAngle = atan2f(forward.z, forward.x) * RAD2DEG;
-
-    // Arm rotation for backhand throw:
-    // - Idle: 0 degrees (forward)
-    // - Charging: winds back up to 90 degrees (across body to the right)
-    // - Throwing: swings from 90 degrees back to 0 (forward release)
-    float armRotation = 0.0f;
-    if (throwProgress > 0.0f) {
-        // During throw: swing from wound-back position to forward
-        armRotation = 90.0f * (1.0f - throwProgress);
-    } else if (chargeProgress > 0.0f) {
-        // During charge: wind back proportional to charge
-        armRotation = 90.0f * chargeProgress;
-    }
-
-    // Draw arm rotated to follow camera direction (Minecraft-style horizontal arm)
-    rlPushMatrix();
-    rlTranslatef(armPos.x, armPos.y, armPos.z);
-    rlRotatef(-yawAngle + 90.0f + armRotation, 0, 1, 0);  // Base rotation + animation
-    // Arm dimensions: width (left-right), height (up-down), length (extends forward)
-    DrawCube((Vector3){0, 0, 0}, 0.35f, 0.1f, 0.12f, BEIGE);
-    rlPopMatrix();
-}
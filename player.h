@@ -5,6 +5,22 @@
 
 #define PLAYER_MAX_HEALTH 5
 #define PLAYER_COLLISION_RADIUS 0.5f
+#define MAX_CHARGE_TIME 1.0f  // 1 second to fully charge
+
+// One frame of player controls, decoupled from the keyboard and mouse
+typedef struct {
+    Vector2 lookDelta;
+    bool moveForward;
+    bool moveBack;
+    bool moveLeft;
+    bool moveRight;
+    bool sprint;
+    bool jump;           // Pressed this frame
+    bool throwPressed;   // Pressed this frame
+    bool throwHeld;
+    bool throwReleased;  // Released this frame
+    bool cycleThrowMode; // Pressed this frame
+} PlayerInput;
 
 typedef struct {
     Vector3 position;
@@ -16,13 +32,14 @@ typedef struct {
     bool isThrowing;
     float chargeTime;
     bool isCharging;
+    float fireCooldown;  // Time until rapid fire may throw again
     int health;
     int maxHealth;
     float damageFlash;
 } Player;
 
 Player InitPlayer(void);
-void UpdatePlayer(Player *player, Camera *camera);
+void UpdatePlayer(Player *player, Camera *camera, const PlayerInput *input, float dt);
 void DrawPlayerHand(Camera camera, float throwProgress, float chargeProgress);
 
 #endif
@@ -0,0 +1,40 @@
+#include "player.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <math.h>
+
+void DrawPlayerHand(Camera camera, float throwProgress, float chargeProgress) {
+    // Get camera's forward and right vectors
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3CrossProduct(forward, camera.up);
+
+    // Arm position: offset right, down, and forward from camera
+    Vector3 armPos = camera.position;
+    armPos = Vector3Add(armPos, Vector3Scale(right, 0.4f));       // right
+    armPos = Vector3Add(armPos, Vector3Scale(camera.up, -0.3f));  // down
+    armPos = Vector3Add(armPos, Vector3Scale(forward, 0.6f));     // forward
+
+    // Calculate yaw angle from camera forward direction
+    float yawAngle = atan2f(forward.z, forward.x) * RAD2DEG;
+
+    // Arm rotation for backhand throw:
+    // - Idle: 0 degrees (forward)
+    // - Charging: winds back up to 90 degrees (across body to the right)
+    // - Throwing: swings from 90 degrees back to 0 (forward release)
+    float armRotation = 0.0f;
+    if (throwProgress > 0.0f) {
+        // During throw: swing from wound-back position to forward
+        armRotation = 90.0f * (1.0f - throwProgress);
+    } else if (chargeProgress > 0.0f) {
+        // During charge: wind back proportional to charge
+        armRotation = 90.0f * chargeProgress;
+    }
+
+    // Draw arm rotated to follow camera direction (Minecraft-style horizontal arm)
+    rlPushMatrix();
+    rlTranslatef(armPos.x, armPos.y, armPos.z);
+    rlRotatef(-yawAngle + 90.0f + armRotation, 0, 1, 0);  // Base rotation + animation
+    // Arm dimensions: width (left-right), height (up-down), length (extends forward)
+    DrawCube((Vector3){0, 0, 0}, 0.35f, 0.1f, 0.12f, BEIGE);
+    rlPopMatrix();
+}
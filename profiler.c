@@ -0,0 +1,227 @@
+#include "profiler.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define PROFILE_FRAME_ZONE "Frame"
+#define PROFILE_AVERAGE_WEIGHT 0.1f
+
+typedef struct {
+    const char *name;
+    int64_t start;  // Nanoseconds since the profiler started
+    int64_t end;
+    int depth;
+} ProfileRecord;
+
+// Everything one thread records. Only the owning thread writes; the trace exporter reads
+// the ring up to head, which is published after each record is complete.
+typedef struct {
+    ProfileRecord ring[PROFILE_RING_SIZE];
+    atomic_uint head;             // Total records written; the ring holds the newest PROFILE_RING_SIZE
+    const char *openNames[PROFILE_MAX_DEPTH];
+    int64_t openStarts[PROFILE_MAX_DEPTH];
+    int depth;
+    unsigned int frameHead;       // head at the last frame mark
+    int64_t frameStart;
+    ProfileZoneStats stats[PROFILE_MAX_STAT_ZONES];
+    int64_t statFirstStart[PROFILE_MAX_STAT_ZONES];  // Keeps parents listed above their children
+    int statCount;
+    const char *threadName;
+} ProfileThread;
+
+static ProfileThread *profileThreads[PROFILE_MAX_THREADS];
+static atomic_int profileThreadCount;
+static pthread_mutex_t profileRegisterLock = PTHREAD_MUTEX_INITIALIZER;
+static _Thread_local ProfileThread *currentThread;
+static _Thread_local bool currentThreadFailed;  // Out of thread slots; stop trying
+static int64_t profileEpoch;
+
+static int64_t ProfileNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec - profileEpoch;
+}
+
+static ProfileThread *GetProfileThread(void) {
+    if (currentThread || currentThreadFailed) return currentThread;
+
+    pthread_mutex_lock(&profileRegisterLock);
+    int index = atomic_load(&profileThreadCount);
+    if (index < PROFILE_MAX_THREADS) {
+        if (index == 0) {
+            profileEpoch = 0;
+            profileEpoch = ProfileNow();
+        }
+        ProfileThread *thread = calloc(1, sizeof(ProfileThread));
+        if (thread) {
+            thread->frameStart = ProfileNow();
+            // The whole frame always heads the stats
+            thread->stats[0] = (ProfileZoneStats){PROFILE_FRAME_ZONE, 0, 0, 0.0f, 0.0f};
+            thread->statCount = 1;
+            profileThreads[index] = thread;
+            atomic_store(&profileThreadCount, index + 1);
+            currentThread = thread;
+        }
+    }
+    pthread_mutex_unlock(&profileRegisterLock);
+
+    if (!currentThread) currentThreadFailed = true;
+    return currentThread;
+}
+
+static void PushRecord(ProfileThread *thread, const char *name, int64_t start, int64_t end, int depth) {
+    unsigned int head = atomic_load_explicit(&thread->head, memory_order_relaxed);
+    thread->ring[head % PROFILE_RING_SIZE] = (ProfileRecord){name, start, end, depth};
+    atomic_store_explicit(&thread->head, head + 1, memory_order_release);
+}
+
+void ProfileBeginZone(const char *name) {
+    ProfileThread *thread = GetProfileThread();
+    if (!thread) return;
+
+    // Zones nested deeper than the stack are counted but not recorded
+    if (thread->depth < PROFILE_MAX_DEPTH) {
+        thread->openNames[thread->depth] = name;
+        thread->openStarts[thread->depth] = ProfileNow();
+    }
+    thread->depth++;
+}
+
+void ProfileEndZone(void) {
+    ProfileThread *thread = currentThread;
+    if (!thread || thread->depth == 0) return;
+
+    thread->depth--;
+    if (thread->depth < PROFILE_MAX_DEPTH) {
+        // Depth 0 is the frame itself
+        PushRecord(thread, thread->openNames[thread->depth], thread->openStarts[thread->depth], ProfileNow(),
+                   thread->depth + 1);
+    }
+}
+
+static ProfileZoneStats *FindZoneStats(ProfileThread *thread, const ProfileRecord *record) {
+    for (int i = 0; i < thread->statCount; i++) {
+        if (thread->stats[i].name == record->name) return &thread->stats[i];
+    }
+    if (thread->statCount >= PROFILE_MAX_STAT_ZONES) return NULL;
+
+    // Records arrive in the order zones end, so a parent shows up after its children.
+    // Insert by start time instead.
+    int i = thread->statCount++;
+    while (i > 1 && thread->statFirstStart[i - 1] > record->start) {
+        thread->stats[i] = thread->stats[i - 1];
+        thread->statFirstStart[i] = thread->statFirstStart[i - 1];
+        i--;
+    }
+    thread->stats[i] = (ProfileZoneStats){record->name, record->depth, 0, 0.0f, 0.0f};
+    thread->statFirstStart[i] = record->start;
+    return &thread->stats[i];
+}
+
+void ProfileFrameMark(void) {
+    ProfileThread *thread = GetProfileThread();
+    if (!thread) return;
+
+    int64_t now = ProfileNow();
+    PushRecord(thread, PROFILE_FRAME_ZONE, thread->frameStart, now, 0);
+
+    for (int i = 0; i < thread->statCount; i++) {
+        thread->stats[i].calls = 0;
+        thread->stats[i].ms = 0.0f;
+    }
+
+    // Total this frame's records, frame record included. If the ring wrapped since the last
+    // mark the oldest ones are gone; sum what is left.
+    unsigned int head = atomic_load_explicit(&thread->head, memory_order_relaxed);
+    unsigned int first = thread->frameHead;
+    if (head - first > PROFILE_RING_SIZE) first = head - PROFILE_RING_SIZE;
+    for (unsigned int i = first; i != head; i++) {
+        ProfileRecord *record = &thread->ring[i % PROFILE_RING_SIZE];
+        ProfileZoneStats *stats = FindZoneStats(thread, record);
+        if (!stats) continue;
+        stats->calls++;
+        stats->ms += (float)(record->end - record->start) / 1e6f;
+    }
+
+    for (int i = 0; i < thread->statCount; i++) {
+        ProfileZoneStats *stats = &thread->stats[i];
+        stats->averageMs += (stats->ms - stats->averageMs) * PROFILE_AVERAGE_WEIGHT;
+    }
+
+    thread->frameHead = head;
+    thread->frameStart = now;
+}
+
+void ProfileSetThreadName(const char *name) {
+    ProfileThread *thread = GetProfileThread();
+    if (thread) thread->threadName = name;
+}
+
+int GetProfileStats(ProfileZoneStats *stats, int maxStats) {
+    ProfileThread *thread = currentThread;
+    if (!thread) return 0;
+
+    int count = thread->statCount < maxStats ? thread->statCount : maxStats;
+    for (int i = 0; i < count; i++) stats[i] = thread->stats[i];
+    return count;
+}
+
+static void WriteJsonString(FILE *file, const char *text) {
+    fputc('"', file);
+    for (const char *c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') fputc('\\', file);
+        if ((unsigned char)*c >= 0x20) fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+bool WriteProfileTrace(const char *path, double seconds) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    int64_t cutoff = ProfileNow() - (int64_t)(seconds * 1e9);
+    bool first = true;
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+
+    int threadCount = atomic_load(&profileThreadCount);
+    for (int t = 0; t < threadCount; t++) {
+        ProfileThread *thread = profileThreads[t];
+
+        fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": ",
+                first ? "" : ",\n", t);
+        if (thread->threadName) {
+            WriteJsonString(file, thread->threadName);
+        } else {
+            fprintf(file, "\"Thread %d\"", t);
+        }
+        fprintf(file, "}}");
+        first = false;
+
+        // Another thread may be appending while we read; records older than the ring are gone
+        // and a record overwritten mid-read only costs one garbled sample in a debug dump
+        unsigned int head = atomic_load_explicit(&thread->head, memory_order_acquire);
+        unsigned int start = head > PROFILE_RING_SIZE ? head - PROFILE_RING_SIZE : 0;
+        for (unsigned int i = start; i != head; i++) {
+            ProfileRecord record = thread->ring[i % PROFILE_RING_SIZE];
+            if (record.end < cutoff) continue;
+            fprintf(file, ",\n{\"name\": ");
+            WriteJsonString(file, record.name);
+            fprintf(file, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                    t, record.start / 1e3, (record.end - record.start) / 1e3);
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+bool IsProfilerEnabled(void) {
+#ifdef FRISBEE_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,52 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+
+#define PROFILE_RING_SIZE 16384      // Finished zones kept per thread, several seconds at 60 FPS
+#define PROFILE_MAX_THREADS 8
+#define PROFILE_MAX_DEPTH 32
+#define PROFILE_MAX_STAT_ZONES 32
+#define PROFILE_TRACE_SECONDS 5.0
+
+// Scoped timing zones. Build with FRISBEE_PROFILE defined to record them; without it the
+// macros expand to nothing and the profiler costs nothing at the call sites.
+//
+//   PROFILE_BEGIN("Enemies");
+//   UpdateEnemies(...);
+//   PROFILE_END();
+//
+// Names must be string literals (or otherwise outlive the profiler): only the pointer is stored.
+#ifdef FRISBEE_PROFILE
+#define PROFILE_BEGIN(name) ProfileBeginZone(name)
+#define PROFILE_END() ProfileEndZone()
+#define PROFILE_FRAME() ProfileFrameMark()
+#else
+#define PROFILE_BEGIN(name) ((void)0)
+#define PROFILE_END() ((void)0)
+#define PROFILE_FRAME() ((void)0)
+#endif
+
+// Time spent in one zone by the calling thread, summed over its calls in a frame
+typedef struct {
+    const char *name;
+    int depth;          // Nesting level the zone was first seen at, for indenting
+    int calls;          // In the last frame
+    float ms;           // In the last frame
+    float averageMs;    // Smoothed over recent frames
+} ProfileZoneStats;
+
+void ProfileBeginZone(const char *name);
+void ProfileEndZone(void);
+// Closes the calling thread's frame: totals its zones since the previous mark for GetProfileStats
+void ProfileFrameMark(void);
+// Names the calling thread in exported traces
+void ProfileSetThreadName(const char *name);
+// Copies the calling thread's per-zone totals for the last frame. Returns the number written.
+int GetProfileStats(ProfileZoneStats *stats, int maxStats);
+// Writes every thread's zones from the last `seconds` as Chrome trace JSON (chrome://tracing,
+// Perfetto). Returns false if the file cannot be written.
+bool WriteProfileTrace(const char *path, double seconds);
+bool IsProfilerEnabled(void);
+
+#endif
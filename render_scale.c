@@ -0,0 +1,119 @@
+#include "render_scale.h"
+#include <math.h>
+#include <string.h>
+
+static float ClampScale(float scale, float min, float max) {
+    if (scale < min) return min;
+    if (scale > max) return max;
+    return scale;
+}
+
+void InitRenderScaler(RenderScaler *scaler, float minScale, float maxScale, float frameBudget) {
+    UnloadRenderScaler(scaler);
+    memset(scaler, 0, sizeof(RenderScaler));
+    scaler->maxScale = ClampScale(maxScale, RENDER_SCALE_GRID, 1.0f);
+    scaler->minScale = ClampScale(minScale, RENDER_SCALE_GRID, scaler->maxScale);
+    scaler->frameBudget = frameBudget;
+    scaler->scale = scaler->maxScale;
+    scaler->previousScale = scaler->scale;
+    scaler->probeWindows = RENDER_SCALE_PROBE_WINDOWS;
+    scaler->decision = scaler->minScale == scaler->maxScale ? RENDER_SCALE_FIXED : RENDER_SCALE_HOLD;
+}
+
+void UnloadRenderScaler(RenderScaler *scaler) {
+    if (scaler->target.id != 0) UnloadRenderTexture(scaler->target);
+    scaler->target = (RenderTexture2D){0};
+}
+
+void RestartRenderScaler(RenderScaler *scaler) {
+    scaler->windowTime = 0.0f;
+    scaler->windowFrames = 0;
+    scaler->settleFrames = RENDER_SCALE_SETTLE_FRAMES;
+}
+
+static void ChangeRenderScale(RenderScaler *scaler, float scale, RenderScaleDecision decision, float frameTime) {
+    scale = ClampScale(scale, scaler->minScale, scaler->maxScale);
+    if (scale == scaler->scale) return;
+    scaler->previousScale = scaler->scale;
+    scaler->scale = scale;
+    scaler->decision = decision;
+    scaler->changeFrameTime = frameTime;
+    scaler->changes++;
+    scaler->windowsOnBudget = 0;
+}
+
+void UpdateRenderScaler(RenderScaler *scaler, float frameTime) {
+    if (scaler->decision == RENDER_SCALE_FIXED) return;
+    if (scaler->settleFrames > 0) {
+        scaler->settleFrames--;
+        return;
+    }
+    if (frameTime > RENDER_SCALE_HITCH) return;
+
+    scaler->windowTime += frameTime;
+    if (++scaler->windowFrames < RENDER_SCALE_WINDOW) return;
+    float average = scaler->windowTime / scaler->windowFrames;
+    scaler->averageFrameTime = average;
+    scaler->windowTime = 0.0f;
+    scaler->windowFrames = 0;
+
+    if (average <= scaler->frameBudget * RENDER_SCALE_OVER_BUDGET) {
+        // A step up that held is worth trying again soon
+        if (scaler->decision == RENDER_SCALE_UP && scaler->windowsOnBudget == 0) {
+            scaler->probeWindows = RENDER_SCALE_PROBE_WINDOWS;
+        }
+        if (++scaler->windowsOnBudget >= scaler->probeWindows) {
+            ChangeRenderScale(scaler, scaler->scale + RENDER_SCALE_STEP_UP, RENDER_SCALE_UP, average);
+            scaler->windowsOnBudget = 0;
+        }
+        return;
+    }
+
+    // A step up that missed straight away: that scale is out of reach for now
+    if (scaler->decision == RENDER_SCALE_UP && scaler->windowsOnBudget == 0 &&
+        scaler->probeWindows < RENDER_SCALE_MAX_PROBE_WINDOWS) {
+        scaler->probeWindows *= 2;
+    }
+    scaler->windowsOnBudget = 0;
+
+    // Drawing cost follows the pixel count, the square of the scale. The rest of the frame
+    // does not shrink with it, so one cut may fall short and the next window cuts again.
+    float scale = scaler->scale * sqrtf(scaler->frameBudget / average);
+    scale = floorf(scale / RENDER_SCALE_GRID + 0.001f) * RENDER_SCALE_GRID;
+    if (scale > scaler->scale - RENDER_SCALE_GRID) scale = scaler->scale - RENDER_SCALE_GRID;
+    ChangeRenderScale(scaler, scale, RENDER_SCALE_DOWN, average);
+}
+
+int GetScaledRenderWidth(const RenderScaler *scaler) {
+    int width = (int)(GetScreenWidth() * scaler->scale + 0.5f);
+    return width > 0 ? width : 1;
+}
+
+int GetScaledRenderHeight(const RenderScaler *scaler) {
+    int height = (int)(GetScreenHeight() * scaler->scale + 0.5f);
+    return height > 0 ? height : 1;
+}
+
+void BeginScaledRender(RenderScaler *scaler) {
+    if (scaler->scale >= 1.0f) return;  // Straight to the screen
+
+    int width = GetScaledRenderWidth(scaler);
+    int height = GetScaledRenderHeight(scaler);
+    if (scaler->target.id == 0 || scaler->target.texture.width != width || scaler->target.texture.height != height) {
+        UnloadRenderScaler(scaler);
+        scaler->target = LoadRenderTexture(width, height);
+        SetTextureFilter(scaler->target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    BeginTextureMode(scaler->target);
+}
+
+void EndScaledRender(RenderScaler *scaler) {
+    if (scaler->scale >= 1.0f) return;
+
+    EndTextureMode();
+    Texture2D texture = scaler->target.texture;
+    // Render textures are stored bottom-up, hence the negative height
+    Rectangle source = {0, 0, (float)texture.width, -(float)texture.height};
+    Rectangle screen = {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+    DrawTexturePro(texture, source, screen, (Vector2){0, 0}, 0.0f, WHITE);
+}
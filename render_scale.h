@@ -0,0 +1,67 @@
+#ifndef RENDER_SCALE_H
+#define RENDER_SCALE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define RENDER_SCALE_MIN_DEFAULT 0.5f
+#define RENDER_SCALE_MAX_DEFAULT 1.0f
+#define RENDER_SCALE_GRID 0.05f         // Scales are kept to multiples of this, so the target is rarely rebuilt
+#define RENDER_SCALE_STEP_UP 0.1f
+#define RENDER_SCALE_WINDOW 30          // Frames averaged for each decision
+#define RENDER_SCALE_OVER_BUDGET 1.1f   // An average this far over the budget is a miss
+#define RENDER_SCALE_PROBE_WINDOWS 4    // Windows on budget before trying a larger scale
+#define RENDER_SCALE_MAX_PROBE_WINDOWS 32
+#define RENDER_SCALE_HITCH 0.25f        // Longer frames are stalls (loading, window drags), not drawing
+#define RENDER_SCALE_SETTLE_FRAMES 3    // Frames ignored after a restart, while a load's stall is still reported
+
+typedef enum {
+    RENDER_SCALE_HOLD,
+    RENDER_SCALE_DOWN,   // Missed the budget
+    RENDER_SCALE_UP,     // On budget long enough to try more pixels
+    RENDER_SCALE_FIXED   // The bounds leave no choice
+} RenderScaleDecision;
+
+// Resolution of the 3D pass, adapted to the measured frame time. Below full scale the scene
+// is drawn into an offscreen target and stretched over the screen, so a fill-bound renderer
+// (software GL on the kiosks) trades sharpness for frame rate. Frame time is the whole frame
+// as GetFrameTime reports it: with the frame limiter it only says whether the budget was met,
+// so headroom is found by stepping up after a run of frames on budget, and a step that misses
+// waits twice as long before the next try.
+typedef struct {
+    float minScale;          // Bounds on the fraction of the screen's width and height drawn
+    float maxScale;
+    float frameBudget;       // Seconds per frame the scale is chosen to meet
+    float scale;
+    RenderTexture2D target;  // At scale, unused while scale is 1
+    // Measuring
+    float windowTime;        // Frame time summed over the current window
+    int windowFrames;
+    int settleFrames;        // Left to ignore after RestartRenderScaler
+    float averageFrameTime;  // Over the last finished window
+    int windowsOnBudget;
+    int probeWindows;        // Windows on budget needed before the next step up
+    // Last decision, for the profiler overlay
+    RenderScaleDecision decision;
+    float previousScale;     // Before the last change
+    float changeFrameTime;   // Average that led to the last change
+    int changes;
+} RenderScaler;
+
+// Bounds are clamped to [RENDER_SCALE_GRID, 1]; equal bounds fix the scale. Call again to
+// change them.
+void InitRenderScaler(RenderScaler *scaler, float minScale, float maxScale, float frameBudget);
+void UnloadRenderScaler(RenderScaler *scaler);
+// Starts a fresh window, ignoring the frames that carry a stall the caller is about to cause
+void RestartRenderScaler(RenderScaler *scaler);
+// Feed each drawn frame's time; every RENDER_SCALE_WINDOW frames the scale may change
+void UpdateRenderScaler(RenderScaler *scaler, float frameTime);
+// Starts drawing the scene at the current scale. Between this and EndScaledRender, draw as
+// if to the screen; everything is stretched over it on the end call.
+void BeginScaledRender(RenderScaler *scaler);
+void EndScaledRender(RenderScaler *scaler);
+// Size the scene is drawn at
+int GetScaledRenderWidth(const RenderScaler *scaler);
+int GetScaledRenderHeight(const RenderScaler *scaler);
+
+#endif
@@ -0,0 +1,181 @@
+#include "replay.h"
+#include <string.h>
+#include <time.h>
+
+#define REPLAY_HEADER_SIZE (20 + LEVEL_NAME_SIZE)
+#define REPLAY_FRAME_SIZE 14
+
+static void PutU16(unsigned char *out, uint16_t value) {
+    out[0] = (unsigned char)value;
+    out[1] = (unsigned char)(value >> 8);
+}
+
+static void PutU32(unsigned char *out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = (unsigned char)(value >> (8 * i));
+}
+
+static void PutF32(unsigned char *out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    PutU32(out, bits);
+}
+
+static uint16_t GetU16(const unsigned char *in) {
+    return (uint16_t)(in[0] | in[1] << 8);
+}
+
+static uint32_t GetU32(const unsigned char *in) {
+    return (uint32_t)in[0] | (uint32_t)in[1] << 8 | (uint32_t)in[2] << 16 | (uint32_t)in[3] << 24;
+}
+
+static float GetF32(const unsigned char *in) {
+    uint32_t bits = GetU32(in);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static bool WriteReplayHeader(Replay *replay) {
+    unsigned char bytes[REPLAY_HEADER_SIZE];
+    ReplayHeader *header = &replay->header;
+    PutU32(bytes, header->magic);
+    PutU16(bytes + 4, header->version);
+    PutU16(bytes + 6, 0);
+    PutU32(bytes + 8, header->seed);
+    PutU32(bytes + 12, header->frameCount);
+    PutU32(bytes + 16, header->checksum);
+    memcpy(bytes + 20, header->levelFile, LEVEL_NAME_SIZE);
+    return fwrite(bytes, sizeof(bytes), 1, replay->file) == 1;
+}
+
+bool OpenReplayRecording(Replay *replay, const char *path, const char *levelFile, uint32_t seed) {
+    memset(replay, 0, sizeof(Replay));
+    replay->file = fopen(path, "wb");
+    if (!replay->file) return false;
+
+    replay->recording = true;
+    replay->header = (ReplayHeader){REPLAY_MAGIC, REPLAY_VERSION, seed, 0, 0, {0}};
+    strncpy(replay->header.levelFile, levelFile, LEVEL_NAME_SIZE - 1);
+    if (!WriteReplayHeader(replay)) {
+        fclose(replay->file);
+        replay->file = NULL;
+        return false;
+    }
+    return true;
+}
+
+void RecordReplayFrame(Replay *replay, const PlayerInput *input, float dt) {
+    if (!replay->file || !replay->recording) return;
+
+    uint16_t buttons = 0;
+    if (input->moveForward) buttons |= REPLAY_BUTTON_FORWARD;
+    if (input->moveBack) buttons |= REPLAY_BUTTON_BACK;
+    if (input->moveLeft) buttons |= REPLAY_BUTTON_LEFT;
+    if (input->moveRight) buttons |= REPLAY_BUTTON_RIGHT;
+    if (input->sprint) buttons |= REPLAY_BUTTON_SPRINT;
+    if (input->jump) buttons |= REPLAY_BUTTON_JUMP;
+    if (input->throwPressed) buttons |= REPLAY_BUTTON_THROW_PRESSED;
+    if (input->throwHeld) buttons |= REPLAY_BUTTON_THROW_HELD;
+    if (input->throwReleased) buttons |= REPLAY_BUTTON_THROW_RELEASED;
+    if (input->cycleThrowMode) buttons |= REPLAY_BUTTON_CYCLE_THROW_MODE;
+
+    unsigned char bytes[REPLAY_FRAME_SIZE];
+    PutU16(bytes, buttons);
+    PutF32(bytes + 2, input->lookDelta.x);
+    PutF32(bytes + 6, input->lookDelta.y);
+    PutF32(bytes + 10, dt);
+    if (fwrite(bytes, sizeof(bytes), 1, replay->file) == 1) replay->framesDone++;
+}
+
+bool OpenReplayPlayback(Replay *replay, const char *path) {
+    memset(replay, 0, sizeof(Replay));
+    replay->file = fopen(path, "rb");
+    if (!replay->file) return false;
+
+    unsigned char bytes[REPLAY_HEADER_SIZE];
+    ReplayHeader *header = &replay->header;
+    if (fread(bytes, sizeof(bytes), 1, replay->file) == 1) {
+        header->magic = GetU32(bytes);
+        header->version = GetU16(bytes + 4);
+        header->seed = GetU32(bytes + 8);
+        header->frameCount = GetU32(bytes + 12);
+        header->checksum = GetU32(bytes + 16);
+        memcpy(header->levelFile, bytes + 20, LEVEL_NAME_SIZE);
+        header->levelFile[LEVEL_NAME_SIZE - 1] = '\0';
+        if (header->magic == REPLAY_MAGIC && header->version == REPLAY_VERSION) return true;
+    }
+
+    fclose(replay->file);
+    replay->file = NULL;
+    return false;
+}
+
+bool ReadReplayFrame(Replay *replay, PlayerInput *input, float *dt) {
+    if (!replay->file || replay->recording) return false;
+    // An unfinished recording has no frame count; play what is there
+    if (replay->header.frameCount > 0 && replay->framesDone >= replay->header.frameCount) return false;
+
+    unsigned char bytes[REPLAY_FRAME_SIZE];
+    if (fread(bytes, sizeof(bytes), 1, replay->file) != 1) return false;
+
+    uint16_t buttons = GetU16(bytes);
+    *input = (PlayerInput){0};
+    input->lookDelta = (Vector2){GetF32(bytes + 2), GetF32(bytes + 6)};
+    input->moveForward = buttons & REPLAY_BUTTON_FORWARD;
+    input->moveBack = buttons & REPLAY_BUTTON_BACK;
+    input->moveLeft = buttons & REPLAY_BUTTON_LEFT;
+    input->moveRight = buttons & REPLAY_BUTTON_RIGHT;
+    input->sprint = buttons & REPLAY_BUTTON_SPRINT;
+    input->jump = buttons & REPLAY_BUTTON_JUMP;
+    input->throwPressed = buttons & REPLAY_BUTTON_THROW_PRESSED;
+    input->throwHeld = buttons & REPLAY_BUTTON_THROW_HELD;
+    input->throwReleased = buttons & REPLAY_BUTTON_THROW_RELEASED;
+    input->cycleThrowMode = buttons & REPLAY_BUTTON_CYCLE_THROW_MODE;
+    *dt = GetF32(bytes + 10);
+    replay->framesDone++;
+    return true;
+}
+
+void CloseReplay(Replay *replay, uint32_t checksum) {
+    if (!replay->file) return;
+
+    if (replay->recording) {
+        replay->header.frameCount = replay->framesDone;
+        replay->header.checksum = checksum;
+        fseek(replay->file, 0, SEEK_SET);
+        WriteReplayHeader(replay);
+    }
+    fclose(replay->file);
+    replay->file = NULL;
+}
+
+bool RunReplayHeadless(const char *path, ReplayResult *result) {
+    Replay replay;
+    if (!OpenReplayPlayback(&replay, path)) return false;
+
+    char levelPath[256];
+    snprintf(levelPath, sizeof(levelPath), "%s/%s%s", LEVEL_DIRECTORY, replay.header.levelFile, LEVEL_EXTENSION);
+    Sim sim;
+    if (!InitSim(&sim, levelPath, replay.header.seed)) {
+        UnloadSim(&sim);
+        CloseReplay(&replay, 0);
+        return false;
+    }
+
+    PlayerInput input;
+    float dt;
+    SimEvents events;
+    double seconds = 0.0;
+    while (ReadReplayFrame(&replay, &input, &dt)) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        UpdateSim(&sim, &input, dt, &events);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        seconds += (double)(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    }
+
+    *result = (ReplayResult){replay.framesDone, seconds, GetSimChecksum(&sim), replay.header.checksum};
+    CloseReplay(&replay, 0);
+    UnloadSim(&sim);
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "sim.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define REPLAY_MAGIC 0x50524646u  // "FFRP" little endian
+#define REPLAY_VERSION 2
+
+// Replay file: a header, then one record per simulation tick. Everything is little endian.
+//
+//   header: magic u32, version u16, reserved u16, seed u32, frameCount u32, checksum u32,
+//           levelFile char[32] (file name in LEVEL_DIRECTORY without extension, NUL padded)
+//   frame:  buttons u16 (REPLAY_BUTTON_* bits), lookDelta.x f32, lookDelta.y f32, dt f32
+//
+// frameCount and checksum (GetSimChecksum after the last frame) are filled in when a
+// recording is closed, so a replay can tell whether it reproduced the session exactly.
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint32_t seed;
+    uint32_t frameCount;
+    uint32_t checksum;
+    char levelFile[LEVEL_NAME_SIZE];
+} ReplayHeader;
+
+typedef enum {
+    REPLAY_BUTTON_FORWARD = 1 << 0,
+    REPLAY_BUTTON_BACK = 1 << 1,
+    REPLAY_BUTTON_LEFT = 1 << 2,
+    REPLAY_BUTTON_RIGHT = 1 << 3,
+    REPLAY_BUTTON_SPRINT = 1 << 4,
+    REPLAY_BUTTON_JUMP = 1 << 5,
+    REPLAY_BUTTON_THROW_PRESSED = 1 << 6,
+    REPLAY_BUTTON_THROW_HELD = 1 << 7,
+    REPLAY_BUTTON_THROW_RELEASED = 1 << 8,
+    REPLAY_BUTTON_CYCLE_THROW_MODE = 1 << 9
+} ReplayButton;
+
+typedef struct {
+    FILE *file;
+    ReplayHeader header;
+    bool recording;
+    uint32_t framesDone;  // Written or read so far
+} Replay;
+
+typedef struct {
+    uint32_t frames;
+    double seconds;       // Wall time spent in UpdateSim
+    uint32_t checksum;
+    uint32_t expected;    // Checksum stored in the file
+} ReplayResult;
+
+bool OpenReplayRecording(Replay *replay, const char *path, const char *levelFile, uint32_t seed);
+void RecordReplayFrame(Replay *replay, const PlayerInput *input, float dt);
+bool OpenReplayPlayback(Replay *replay, const char *path);
+// Returns false once the recording runs out
+bool ReadReplayFrame(Replay *replay, PlayerInput *input, float *dt);
+// Finishes a recording with the final state checksum (ignored for playback) and closes the file
+void CloseReplay(Replay *replay, uint32_t checksum);
+// Runs a whole recording through the simulation as fast as possible, with no window.
+// The level is loaded from LEVEL_DIRECTORY, relative to the working directory.
+bool RunReplayHeadless(const char *path, ReplayResult *result);
+
+#endif
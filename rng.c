@@ -0,0 +1,19 @@
+#include "rng.h"
+
+uint32_t SeedRandom(uint32_t seed) {
+    // Scramble so nearby seeds start far apart; xorshift never leaves a zero state
+    uint32_t state = seed * 0x9E3779B9u + 0x7F4A7C15u;
+    state ^= state >> 16;
+    state *= 0x85EBCA6Bu;
+    state ^= state >> 13;
+    return state != 0 ? state : 0x6D2B79F5u;
+}
+
+int NextRandom(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (int)(x >> 1);
+}
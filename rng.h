@@ -0,0 +1,12 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Small seeded generator for the simulation. Unlike rand() its state lives with the caller,
+// so a run is reproduced exactly by its seed and nothing else can disturb the sequence.
+uint32_t SeedRandom(uint32_t seed);
+// Next value in [0, 0x7fffffff]; advances state
+int NextRandom(uint32_t *state);
+
+#endif
@@ -0,0 +1,293 @@
+#include "sim.h"
+#include "camera.h"
+#include "profiler.h"
+#include "raymath.h"
+#include <stddef.h>
+#include <string.h>
+
+static void PushEvent(SimEvents *events, SimEventType type, Vector3 position, float value) {
+    if (events->count >= MAX_SIM_EVENTS) return;
+    events->events[events->count++] = (SimEvent){type, position, value};
+}
+
+bool InitSim(Sim *sim, const char *levelPath, uint32_t seed) {
+    bool loaded = levelPath && LoadLevel(&sim->level, levelPath);
+    if (!loaded) sim->level = (Level){0};
+
+    sim->seed = seed;
+    sim->rng = SeedRandom(seed);
+    sim->world = loaded ? GetLevelWorld(&sim->level) : BuildArenaWorld();
+    sim->camera = InitCamera();
+    sim->previousCamera = sim->camera;
+    sim->throwMode = THROW_MODE_SINGLE;
+    sim->player = InitPlayer();
+    if (loaded) {
+        sim->player.position.x = sim->level.header->playerStartX;
+        sim->player.position.z = sim->level.header->playerStartZ;
+    }
+    InitEntityStore(&sim->actors);
+    sim->enemies = InitEnemyManager(&sim->actors, &sim->world, 0, &sim->rng);
+    if (sim->enemies.archetype < 0) loaded = false;
+    sim->dormant = (DormantEnemies){0};
+    sim->active = GetWorldChunkRange(&sim->world, sim->player.position.x, sim->player.position.z,
+                                     WORLD_STREAM_RADIUS);
+    for (int cz = sim->active.minZ; cz <= sim->active.maxZ; cz++) {
+        for (int cx = sim->active.minX; cx <= sim->active.maxX; cx++) {
+            SetLevelChunkResident(&sim->level, cz * sim->world.chunkDim + cx, true);
+        }
+    }
+    sim->wave = 0;
+    sim->waveTimer = 0.0f;
+    return loaded;
+}
+
+void UnloadSim(Sim *sim) {
+    UnloadEnemyManager(&sim->enemies);
+    UnloadEntityStore(&sim->actors);
+    UnloadDormantEnemies(&sim->dormant);
+    UnloadStaticWorld(&sim->world);
+    UnloadLevel(&sim->level);
+}
+
+static int GetSimWaveCount(const Sim *sim) {
+    return sim->level.header ? (int)sim->level.header->waves.count : 0;
+}
+
+int GetSimEnemiesRemaining(const Sim *sim) {
+    int remaining = CountEntities(&sim->actors, TARGET_COMPONENTS) + sim->dormant.count;
+    for (int w = sim->wave; w < GetSimWaveCount(sim); w++) remaining += sim->level.waves[w].enemyCount;
+    return remaining;
+}
+
+// Deals the wave's enemies out over the spawn points, starting from a random one, and
+// spreads each point's share over its spawn square. A square without room for its share
+// gets fewer; the wave is then cleared once the ones that did appear are gone.
+static void SpawnWave(Sim *sim, const LevelWave *wave) {
+    int spawnCount = (int)sim->level.header->spawns.count;
+    int first = NextRandom(&sim->rng) % spawnCount;
+    for (int i = 0; i < spawnCount && i < wave->enemyCount; i++) {
+        const LevelSpawn *spawn = &sim->level.spawns[(first + i) % spawnCount];
+        int count = wave->enemyCount / spawnCount + (i < wave->enemyCount % spawnCount ? 1 : 0);
+        SpawnEnemies(&sim->enemies, &sim->actors, &sim->world, GetLevelSpawnArea(*spawn), sim->player.position, count,
+                     &sim->rng);
+    }
+}
+
+static bool IsChunkInRange(WorldChunkRange range, int cx, int cz) {
+    return cx >= range.minX && cx <= range.maxX && cz >= range.minZ && cz <= range.maxZ;
+}
+
+// Follows the player across chunk borders: collision data of chunks entering the range is
+// paged in ahead of use and that of chunks leaving it is released, and enemies left
+// outside go dormant
+static void UpdateActiveChunks(Sim *sim) {
+    WorldChunkRange range = GetWorldChunkRange(&sim->world, sim->player.position.x, sim->player.position.z,
+                                               WORLD_STREAM_RADIUS);
+    if (memcmp(&range, &sim->active, sizeof(WorldChunkRange)) == 0) return;
+
+    WorldChunkRange old = sim->active;
+    int minX = range.minX < old.minX ? range.minX : old.minX;
+    int maxX = range.maxX > old.maxX ? range.maxX : old.maxX;
+    int minZ = range.minZ < old.minZ ? range.minZ : old.minZ;
+    int maxZ = range.maxZ > old.maxZ ? range.maxZ : old.maxZ;
+    for (int cz = minZ; cz <= maxZ; cz++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            bool resident = IsChunkInRange(range, cx, cz);
+            if (resident != IsChunkInRange(old, cx, cz)) {
+                SetLevelChunkResident(&sim->level, cz * sim->world.chunkDim + cx, resident);
+            }
+        }
+    }
+
+    sim->active = range;
+    SuspendEnemies(&sim->enemies, &sim->actors, &sim->dormant, GetWorldChunkRangeBounds(&sim->world, range));
+}
+
+typedef struct {
+    Sim *sim;
+    SimEvents *events;
+} DiscCollisionSystem;
+
+// Stops each disc that hit an enemy where it hit
+static void CollideDiscs(Archetype *discs, void *context) {
+    DiscCollisionSystem *system = context;
+    Vector3 *bodies = discs->columns[COMPONENT_BODY];
+    FrisbeeSweep *sweeps = discs->columns[COMPONENT_SWEEP];
+    FrisbeeHit hits[MAX_FRISBEES];
+    int hitCount = CheckFrisbeeEnemyCollisions(&system->sim->enemies, &system->sim->actors, sweeps, discs->count,
+                                               FRISBEE_RADIUS, hits);
+    for (int i = 0; i < hitCount; i++) {
+        FrisbeeSweep *sweep = &sweeps[hits[i].frisbee];
+        Vector3 hitPos = Vector3Lerp(sweep->start, sweep->end, hits[i].hitTime);
+        bodies[hits[i].frisbee] = hitPos;
+        sweep->stopped = true;
+        PushEvent(system->events, hits[i].result == 2 ? SIM_EVENT_ENEMY_KILLED : SIM_EVENT_ENEMY_DAMAGED, hitPos,
+                  0.0f);
+    }
+}
+
+void UpdateSim(Sim *sim, const PlayerInput *input, float dt, SimEvents *events) {
+    Player *player = &sim->player;
+    EntityStore *actors = &sim->actors;
+
+    events->count = 0;
+    sim->previousCamera = sim->camera;
+
+    PROFILE_BEGIN("Player");
+    UpdatePlayer(player, &sim->camera, input, dt);
+
+    bool isMoving = input->moveForward || input->moveBack || input->moveLeft || input->moveRight;
+    events->walking = isMoving && player->isGrounded;
+    UpdateActiveChunks(sim);
+    PROFILE_END();
+
+    // Update enemies
+    PROFILE_BEGIN("Enemies");
+    Rectangle activeBounds = GetWorldChunkRangeBounds(&sim->world, sim->active);
+    int targets = CountEntities(actors, TARGET_COMPONENTS);
+    if (targets == 0 && sim->dormant.count == 0 && sim->wave < GetSimWaveCount(sim)) {
+        const LevelWave *wave = &sim->level.waves[sim->wave];
+        sim->waveTimer += dt;
+        if (sim->waveTimer >= wave->delay) {
+            SpawnWave(sim, wave);
+            SuspendEnemies(&sim->enemies, actors, &sim->dormant, activeBounds);
+            sim->wave++;
+            sim->waveTimer = 0.0f;
+            PushEvent(events, SIM_EVENT_WAVE_STARTED, player->position, (float)sim->wave);
+        }
+    }
+    UpdateDormantEnemies(&sim->enemies, actors, &sim->dormant, activeBounds, player->position, dt);
+    UpdateEnemies(&sim->enemies, actors, &sim->world, player->position, dt);
+    PROFILE_END();
+
+    PROFILE_BEGIN("Frisbees");
+    if (input->cycleThrowMode) {
+        sim->throwMode = (sim->throwMode + 1) % THROW_MODE_COUNT;
+        player->isCharging = false;
+        player->chargeTime = 0.0f;
+    }
+
+    if (sim->throwMode == THROW_MODE_RAPID) {
+        // Hold to fire at a fixed rate, no charging
+        if (player->fireCooldown > 0.0f) player->fireCooldown -= dt;
+        if (input->throwHeld && player->fireCooldown <= 0.0f) {
+            if (ThrowFrisbee(actors, player, sim->camera, RAPID_FIRE_CHARGE, 0.0f) != ENTITY_NONE) {
+                PushEvent(events, SIM_EVENT_THROW, sim->camera.position, RAPID_FIRE_CHARGE);
+            }
+            player->fireCooldown += RAPID_FIRE_INTERVAL;
+            if (player->fireCooldown < 0.0f) player->fireCooldown = 0.0f;
+        }
+    } else if (!player->isThrowing && (sim->throwMode != THROW_MODE_SINGLE ||
+                                       CountEntities(actors, FLIGHT_COMPONENTS) == 0)) {
+        // Handle charge and throw input
+        if (input->throwPressed) {
+            // Start charging
+            player->isCharging = true;
+            player->chargeTime = 0.0f;
+        }
+
+        if (player->isCharging && input->throwHeld) {
+            // Accumulate charge
+            player->chargeTime += dt;
+            if (player->chargeTime > MAX_CHARGE_TIME) {
+                player->chargeTime = MAX_CHARGE_TIME;
+            }
+        }
+
+        if (player->isCharging && input->throwReleased) {
+            // Release throw
+            float chargePercent = player->chargeTime / MAX_CHARGE_TIME;
+            if (sim->throwMode == THROW_MODE_SPREAD) {
+                float firstOffset = -SPREAD_ANGLE * (SPREAD_FRISBEE_COUNT - 1) / 2.0f;
+                for (int i = 0; i < SPREAD_FRISBEE_COUNT; i++) {
+                    ThrowFrisbee(actors, player, sim->camera, chargePercent, firstOffset + SPREAD_ANGLE * i);
+                }
+            } else {
+                ThrowFrisbee(actors, player, sim->camera, chargePercent, 0.0f);
+            }
+            PushEvent(events, SIM_EVENT_THROW, sim->camera.position, chargePercent);
+            player->isCharging = false;
+            player->chargeTime = 0.0f;
+        }
+    }
+
+    // Update frisbee physics, all discs in one pass
+    UpdateFrisbees(actors, &sim->world, dt);
+    PROFILE_END();
+
+    PROFILE_BEGIN("Collisions");
+    // Frisbee-enemy collision along every path, up to where each disc hit the world, then
+    // the discs that stopped and the enemies that died leave the store
+    DiscCollisionSystem collisions = {sim, events};
+    RunSystem(actors, COMPONENT_BIT(COMPONENT_BODY) | COMPONENT_BIT(COMPONENT_SWEEP), CollideDiscs, &collisions);
+    RemoveStoppedFrisbees(actors);
+    RemoveDeadEnemies(&sim->enemies, actors);
+
+    // Enemy-player collision
+    int damage = CheckEnemyPlayerCollision(&sim->enemies, actors, player->position, PLAYER_COLLISION_RADIUS, dt);
+    if (damage > 0) {
+        player->health -= damage;
+        player->damageFlash = 0.3f;
+        PushEvent(events, SIM_EVENT_PLAYER_DAMAGED, player->position, (float)damage);
+    }
+    PROFILE_END();
+
+    // Update damage flash
+    if (player->damageFlash > 0.0f) {
+        player->damageFlash -= dt;
+    }
+
+    // Win/lose conditions
+    if (player->health <= 0) {
+        PushEvent(events, SIM_EVENT_PLAYER_KILLED, player->position, 0.0f);
+    }
+    if (CountEntities(actors, TARGET_COMPONENTS) == 0 && sim->dormant.count == 0 &&
+        sim->wave >= GetSimWaveCount(sim)) {
+        PushEvent(events, SIM_EVENT_ALL_ENEMIES_KILLED, player->position, 0.0f);
+    }
+
+    // Update throw animation timer
+    if (player->isThrowing) {
+        player->throwTimer -= dt;
+        if (player->throwTimer <= 0) {
+            player->isThrowing = false;
+        }
+    }
+}
+
+static uint32_t HashBytes(uint32_t hash, const void *data, size_t size) {
+    // FNV-1a
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t GetSimChecksum(const Sim *sim) {
+    const Player *player = &sim->player;
+
+    uint32_t hash = 2166136261u;
+    hash = HashBytes(hash, &player->position, sizeof(player->position));
+    hash = HashBytes(hash, &player->yaw, sizeof(player->yaw));
+    hash = HashBytes(hash, &player->pitch, sizeof(player->pitch));
+    hash = HashBytes(hash, &player->health, sizeof(player->health));
+    hash = HashBytes(hash, &sim->rng, sizeof(sim->rng));
+    hash = HashBytes(hash, &sim->wave, sizeof(sim->wave));
+    // Each archetype's rows in order, enemies by ground position and health, discs by body
+    for (int a = 0; a < sim->actors.archetypeCount; a++) {
+        const Archetype *actors = &sim->actors.archetypes[a];
+        hash = HashBytes(hash, &actors->count, sizeof(actors->count));
+        if (HasComponents(actors, TARGET_COMPONENTS)) {
+            hash = HashBytes(hash, actors->columns[COMPONENT_POSITION_X], sizeof(float) * actors->count);
+            hash = HashBytes(hash, actors->columns[COMPONENT_POSITION_Z], sizeof(float) * actors->count);
+            hash = HashBytes(hash, actors->columns[COMPONENT_HEALTH], sizeof(int) * actors->count);
+        }
+        if (HasComponents(actors, COMPONENT_BIT(COMPONENT_BODY))) {
+            hash = HashBytes(hash, actors->columns[COMPONENT_BODY], sizeof(Vector3) * actors->count);
+        }
+    }
+    hash = HashBytes(hash, sim->dormant.items, sizeof(DormantEnemy) * sim->dormant.count);
+    return hash;
+}
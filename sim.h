@@ -0,0 +1,69 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include "raylib.h"
+#include "player.h"
+#include "frisbee.h"
+#include "enemy.h"
+#include "world.h"
+#include "level.h"
+#include "rng.h"
+#include <stdint.h>
+
+#define MAX_SIM_EVENTS 128
+#define SIM_TICK_RATE 120  // Fixed simulation steps per second, whatever the display does
+#define SIM_TICK_DT (1.0f / SIM_TICK_RATE)
+
+typedef enum {
+    SIM_EVENT_THROW,              // value = charge percent (0.0 to 1.0)
+    SIM_EVENT_ENEMY_DAMAGED,
+    SIM_EVENT_ENEMY_KILLED,
+    SIM_EVENT_PLAYER_DAMAGED,     // value = damage taken this frame
+    SIM_EVENT_PLAYER_KILLED,
+    SIM_EVENT_WAVE_STARTED,       // value = wave number, from 1
+    SIM_EVENT_ALL_ENEMIES_KILLED  // Every wave has spawned and been cleared
+} SimEventType;
+
+typedef struct {
+    SimEventType type;
+    Vector3 position;
+    float value;
+} SimEvent;
+
+// Everything the simulation wants the outside world to react to (audio, state changes)
+typedef struct {
+    SimEvent events[MAX_SIM_EVENTS];
+    int count;
+    bool walking;  // Player is moving on the ground this frame
+} SimEvents;
+
+typedef struct {
+    Level level;        // Mapped for the whole run; world borrows its obstacles
+    StaticWorld world;
+    Camera camera;
+    Camera previousCamera;  // Camera before the last UpdateSim, for interpolated drawing
+    Player player;
+    ThrowMode throwMode;
+    EntityStore actors;      // Enemies and discs in flight
+    EnemyManager enemies;    // Enemy systems' shared state: broadphase and flow field
+    DormantEnemies dormant;  // Enemies outside the active chunks
+    WorldChunkRange active;  // Chunks around the player that are fully simulated
+    int wave;           // Waves spawned so far
+    float waveTimer;    // Time since the field was last cleared
+    uint32_t seed;  // Everything random in a run derives from this
+    uint32_t rng;
+} Sim;
+
+// Pure simulation: no window, input polling or audio calls, so it can run headless.
+// Plays the level file at levelPath; NULL (or a file that fails to load, which returns
+// false) gives the built-in arena with no enemies.
+bool InitSim(Sim *sim, const char *levelPath, uint32_t seed);
+void UnloadSim(Sim *sim);
+void UpdateSim(Sim *sim, const PlayerInput *input, float dt, SimEvents *events);
+// Enemies alive (active or dormant) plus those the waves still to come ask for; a wave
+// that finds too little room spawns fewer
+int GetSimEnemiesRemaining(const Sim *sim);
+// Hash of the simulation state, to check that two runs ended bit-for-bit identical
+uint32_t GetSimChecksum(const Sim *sim);
+
+#endif
@@ -0,0 +1,211 @@
+#include "simthread.h"
+#include "profiler.h"
+#include "raymath.h"
+#include <string.h>
+#include <time.h>
+
+// `latest` holds a slot index in its low bits and this flag while the renderer has not taken it
+#define SIM_SNAPSHOT_FRESH 4
+#define SIM_SNAPSHOT_INDEX 3
+
+double GetSimThreadTime(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void WriteSnapshot(SimSnapshot *snapshot, const Sim *sim) {
+    snapshot->time = GetSimThreadTime();
+    snapshot->player = sim->player;
+    snapshot->camera = sim->camera;
+    snapshot->previousCamera = sim->previousCamera;
+    snapshot->throwMode = sim->throwMode;
+    CopyEntityStore(&snapshot->actors, &sim->actors, SNAPSHOT_COMPONENTS);
+    snapshot->dormantCount = sim->dormant.count;
+    snapshot->wave = sim->wave;
+    snapshot->enemiesRemaining = GetSimEnemiesRemaining(sim);
+}
+
+// Swaps the finished slot in as the newest and takes back whichever slot it replaced
+static void PublishSnapshot(SimThread *thread) {
+    int previous = atomic_exchange(&thread->latest, thread->writing | SIM_SNAPSHOT_FRESH);
+    thread->writing = previous & SIM_SNAPSHOT_INDEX;
+}
+
+const SimSnapshot *AcquireSimSnapshot(SimThread *thread) {
+    // Only this thread clears the flag, so a fresh slot stays fresh until the exchange
+    if (atomic_load(&thread->latest) & SIM_SNAPSHOT_FRESH) {
+        int previous = atomic_exchange(&thread->latest, thread->reading);
+        thread->reading = previous & SIM_SNAPSHOT_INDEX;
+    }
+    return &thread->snapshots[thread->reading];
+}
+
+float GetSnapshotAlpha(const SimSnapshot *snapshot) {
+    float alpha = (float)((GetSimThreadTime() - snapshot->time) / SIM_TICK_DT);
+    return Clamp(alpha, 0.0f, 1.0f);
+}
+
+Camera GetSnapshotCamera(const SimSnapshot *snapshot, float alpha) {
+    Camera camera = snapshot->camera;
+    camera.position = Vector3Lerp(snapshot->previousCamera.position, snapshot->camera.position, alpha);
+    camera.target = Vector3Lerp(snapshot->previousCamera.target, snapshot->camera.target, alpha);
+    return camera;
+}
+
+// One fixed step: input from the main thread (or the replay), the update, then the results
+// out. Returns false once the sim has stopped for good.
+static bool RunSimTick(SimThread *thread) {
+    PlayerInput input;
+    float dt = SIM_TICK_DT;
+    Replay *replay = thread->replay;
+    if (replay && replay->file && !replay->recording) {
+        if (!ReadReplayFrame(replay, &input, &dt)) {
+            pthread_mutex_lock(&thread->lock);
+            thread->status = SIM_THREAD_REPLAY_ENDED;
+            pthread_mutex_unlock(&thread->lock);
+            return false;
+        }
+    } else {
+        pthread_mutex_lock(&thread->lock);
+        input = thread->pendingInput;
+        // Only the held state carries over to the next tick
+        thread->pendingInput.lookDelta = (Vector2){0};
+        thread->pendingInput.jump = false;
+        thread->pendingInput.throwPressed = false;
+        thread->pendingInput.throwReleased = false;
+        thread->pendingInput.cycleThrowMode = false;
+        pthread_mutex_unlock(&thread->lock);
+        if (replay) RecordReplayFrame(replay, &input, dt);
+    }
+
+    SimEvents events;
+    PROFILE_BEGIN("Sim");
+    UpdateSim(thread->sim, &input, dt, &events);
+    PROFILE_END();
+
+    PROFILE_BEGIN("Snapshot");
+    WriteSnapshot(&thread->snapshots[thread->writing], thread->sim);
+    PublishSnapshot(thread);
+    PROFILE_END();
+
+    bool finished = false;
+    pthread_mutex_lock(&thread->lock);
+    for (int i = 0; i < events.count; i++) {
+        SimEventType type = events.events[i].type;
+        if (type == SIM_EVENT_PLAYER_KILLED || type == SIM_EVENT_ALL_ENEMIES_KILLED) finished = true;
+        if (thread->eventCount < SIM_THREAD_EVENT_CAPACITY) thread->events[thread->eventCount++] = events.events[i];
+    }
+    thread->walking = events.walking;
+    if (finished) thread->status = SIM_THREAD_FINISHED;
+    pthread_mutex_unlock(&thread->lock);
+    return !finished;
+}
+
+// Runs every tick that is due by now. After a stall only SIM_MAX_CATCH_UP worth of
+// ticks run back to back; the rest of the backlog is dropped rather than chased.
+static bool RunDueTicks(SimThread *thread) {
+    double now = GetSimThreadTime();
+    if (now - thread->nextTick > SIM_MAX_CATCH_UP) thread->nextTick = now - SIM_MAX_CATCH_UP;
+    while (thread->nextTick <= now) {
+        if (!RunSimTick(thread)) return false;
+        thread->nextTick += SIM_TICK_DT;
+        PROFILE_FRAME();
+    }
+    return true;
+}
+
+static void *SimThreadMain(void *context) {
+    SimThread *thread = context;
+    ProfileSetThreadName("Sim");
+
+    while (!atomic_load(&thread->stop) && RunDueTicks(thread)) {
+        double wait = thread->nextTick - GetSimThreadTime();
+        if (wait <= 0.0) continue;
+        struct timespec ts = {0, (long)(wait * 1e9)};
+        nanosleep(&ts, NULL);
+    }
+    return NULL;
+}
+
+void InitSimThread(SimThread *thread) {
+    memset(thread, 0, sizeof(SimThread));
+    pthread_mutex_init(&thread->lock, NULL);
+}
+
+void StartSimThread(SimThread *thread, Sim *sim, Replay *replay) {
+    thread->sim = sim;
+    thread->replay = replay;
+    thread->pendingInput = (PlayerInput){0};
+    thread->eventCount = 0;
+    thread->walking = false;
+    thread->status = SIM_THREAD_RUNNING;
+    atomic_store(&thread->stop, false);
+
+    // The renderer may look before the first tick lands
+    WriteSnapshot(&thread->snapshots[0], sim);
+    thread->reading = 0;
+    atomic_store(&thread->latest, 1);
+    thread->writing = 2;
+
+    thread->nextTick = GetSimThreadTime();
+    if (pthread_create(&thread->thread, NULL, SimThreadMain, thread) == 0) {
+        thread->started = true;
+    } else {
+        TraceLog(LOG_WARNING, "SIM: Failed to start simulation thread, ticking on the main thread");
+    }
+}
+
+void PumpSimThread(SimThread *thread) {
+    if (thread->started || thread->status != SIM_THREAD_RUNNING) return;
+    RunDueTicks(thread);
+}
+
+void StopSimThread(SimThread *thread) {
+    if (!thread->started) return;
+    atomic_store(&thread->stop, true);
+    pthread_join(thread->thread, NULL);
+    thread->started = false;
+}
+
+void UnloadSimThread(SimThread *thread) {
+    StopSimThread(thread);
+    for (int i = 0; i < SIM_SNAPSHOT_COUNT; i++) UnloadEntityStore(&thread->snapshots[i].actors);
+    pthread_mutex_destroy(&thread->lock);
+}
+
+void PostSimInput(SimThread *thread, const PlayerInput *input) {
+    pthread_mutex_lock(&thread->lock);
+    PlayerInput *pending = &thread->pendingInput;
+    pending->lookDelta.x += input->lookDelta.x;
+    pending->lookDelta.y += input->lookDelta.y;
+    pending->moveForward = input->moveForward;
+    pending->moveBack = input->moveBack;
+    pending->moveLeft = input->moveLeft;
+    pending->moveRight = input->moveRight;
+    pending->sprint = input->sprint;
+    pending->throwHeld = input->throwHeld;
+    pending->jump |= input->jump;
+    pending->throwPressed |= input->throwPressed;
+    pending->throwReleased |= input->throwReleased;
+    pending->cycleThrowMode |= input->cycleThrowMode;
+    pthread_mutex_unlock(&thread->lock);
+}
+
+void TakeSimEvents(SimThread *thread, SimEvents *events) {
+    pthread_mutex_lock(&thread->lock);
+    int count = thread->eventCount < MAX_SIM_EVENTS ? thread->eventCount : MAX_SIM_EVENTS;
+    memcpy(events->events, thread->events, count * sizeof(SimEvent));
+    thread->eventCount -= count;
+    memmove(thread->events, thread->events + count, thread->eventCount * sizeof(SimEvent));
+    events->count = count;
+    events->walking = thread->walking;
+    pthread_mutex_unlock(&thread->lock);
+}
+
+SimThreadStatus GetSimThreadStatus(SimThread *thread) {
+    pthread_mutex_lock(&thread->lock);
+    SimThreadStatus status = thread->status;
+    pthread_mutex_unlock(&thread->lock);
+    return status;
+}
@@ -0,0 +1,90 @@
+#ifndef SIMTHREAD_H
+#define SIMTHREAD_H
+
+#include "sim.h"
+#include "replay.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#define SIM_SNAPSHOT_COUNT 3         // One being written, one published, one being drawn
+#define SIM_MAX_CATCH_UP 0.1         // Seconds of ticks the thread runs back to back after a stall
+#define SIM_THREAD_EVENT_CAPACITY 1024
+// What drawing and the HUD read from each entity
+#define SNAPSHOT_COMPONENTS (COMPONENT_BIT(COMPONENT_POSITION_X) | COMPONENT_BIT(COMPONENT_POSITION_Z) | \
+                             COMPONENT_BIT(COMPONENT_PREVIOUS_X) | COMPONENT_BIT(COMPONENT_PREVIOUS_Z) | \
+                             COMPONENT_BIT(COMPONENT_HEALTH) | COMPONENT_BIT(COMPONENT_WALK_PHASE) | \
+                             COMPONENT_BIT(COMPONENT_BODY) | COMPONENT_BIT(COMPONENT_SWEEP))
+
+// Everything the renderer and HUD need from one tick, copied out so the simulation can
+// move on while it is drawn. Previous-tick positions come along for interpolation.
+typedef struct {
+    double time;           // GetSimThreadTime() when the tick finished
+    Player player;
+    Camera camera;
+    Camera previousCamera;
+    ThrowMode throwMode;
+    EntityStore actors;    // SNAPSHOT_COMPONENTS columns only, with no ids; sweeps hold each disc's previous position
+    int dormantCount;
+    int wave;
+    int enemiesRemaining;
+} SimSnapshot;
+
+typedef enum {
+    SIM_THREAD_IDLE,
+    SIM_THREAD_RUNNING,
+    SIM_THREAD_FINISHED,     // The level was won or lost; the sim no longer advances
+    SIM_THREAD_REPLAY_ENDED  // Playback ran out before the level ended
+} SimThreadStatus;
+
+// Runs UpdateSim on its own thread at SIM_TICK_RATE, against the clock rather than the
+// frame rate, so a slow frame and a slow tick overlap instead of adding up. The main
+// thread posts input and takes events through a locked queue; tick results come back as
+// snapshots in a lock-free triple buffer, so neither side ever waits for the other.
+//
+// While the thread runs, the Sim belongs to it: read only its world and level, which
+// never change after InitSim, and use snapshots for the rest. Initialized in place.
+typedef struct {
+    Sim *sim;
+    Replay *replay;             // Recorded to or played from on the sim thread
+    SimSnapshot snapshots[SIM_SNAPSHOT_COUNT];
+    atomic_int latest;          // Newest published snapshot, plus SIM_SNAPSHOT_FRESH until taken
+    int writing;                // Sim thread only
+    int reading;                // Main thread only
+    pthread_mutex_t lock;
+    PlayerInput pendingInput;   // Guarded by lock: input posted since the last tick
+    SimEvent events[SIM_THREAD_EVENT_CAPACITY];  // Guarded by lock: not yet taken
+    int eventCount;
+    bool walking;               // Guarded by lock: footsteps as of the last tick
+    SimThreadStatus status;     // Guarded by lock
+    double nextTick;            // GetSimThreadTime() the next tick is due at
+    atomic_bool stop;
+    pthread_t thread;
+    bool started;
+} SimThread;
+
+void InitSimThread(SimThread *thread);
+// Publishes the sim's current state and starts ticking it. replay may be NULL.
+void StartSimThread(SimThread *thread, Sim *sim, Replay *replay);
+// Joins the thread; the Sim is the caller's again afterwards
+void StopSimThread(SimThread *thread);
+// Runs the due ticks on the caller instead. Only does anything when the thread could not
+// be started, so call it once a frame regardless.
+void PumpSimThread(SimThread *thread);
+void UnloadSimThread(SimThread *thread);
+
+// Folds one frame of input into what the next tick sees. Presses, releases and mouse
+// movement wait for a tick to consume them, so none are lost or repeated; held keys
+// take their latest state.
+void PostSimInput(SimThread *thread, const PlayerInput *input);
+// Moves up to MAX_SIM_EVENTS queued events into `events`, oldest first
+void TakeSimEvents(SimThread *thread, SimEvents *events);
+SimThreadStatus GetSimThreadStatus(SimThread *thread);
+// Newest published snapshot. Stays valid and unchanged until the next call.
+const SimSnapshot *AcquireSimSnapshot(SimThread *thread);
+// How far the present lies past the snapshot's tick, as an interpolation factor from 0 to 1
+float GetSnapshotAlpha(const SimSnapshot *snapshot);
+Camera GetSnapshotCamera(const SimSnapshot *snapshot, float alpha);
+double GetSimThreadTime(void);
+
+#endif
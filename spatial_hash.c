@@ -0,0 +1,114 @@
+#include "spatial_hash.h"
+#include <stdlib.h>
+#include <math.h>
+
+static int CellCoord(float v) {
+    return (int)floorf(v / SPATIAL_HASH_CELL_SIZE);
+}
+
+static int BucketOfCell(int cx, int cz) {
+    return (cx & (SPATIAL_HASH_DIM - 1)) + (cz & (SPATIAL_HASH_DIM - 1)) * SPATIAL_HASH_DIM;
+}
+
+void InitSpatialHash(SpatialHash *hash) {
+    *hash = (SpatialHash){0};
+    hash->head = malloc(SPATIAL_HASH_BUCKETS * sizeof(int));
+    for (int i = 0; i < SPATIAL_HASH_BUCKETS; i++) hash->head[i] = -1;
+}
+
+void UnloadSpatialHash(SpatialHash *hash) {
+    free(hash->head);
+    free(hash->next);
+    free(hash->prev);
+    free(hash->bucket);
+    *hash = (SpatialHash){0};
+}
+
+void ReserveSpatialHash(SpatialHash *hash, int capacity) {
+    if (capacity <= hash->capacity) return;
+    hash->next = realloc(hash->next, capacity * sizeof(int));
+    hash->prev = realloc(hash->prev, capacity * sizeof(int));
+    hash->bucket = realloc(hash->bucket, capacity * sizeof(int));
+    hash->capacity = capacity;
+}
+
+static int GetSpatialHashBucket(float x, float z) {
+    return BucketOfCell(CellCoord(x), CellCoord(z));
+}
+
+static void LinkId(SpatialHash *hash, int id, int bucket) {
+    int first = hash->head[bucket];
+    hash->bucket[id] = bucket;
+    hash->prev[id] = -1;
+    hash->next[id] = first;
+    if (first != -1) hash->prev[first] = id;
+    hash->head[bucket] = id;
+}
+
+static void UnlinkId(SpatialHash *hash, int id) {
+    int prev = hash->prev[id];
+    int next = hash->next[id];
+    if (prev != -1) hash->next[prev] = next;
+    else hash->head[hash->bucket[id]] = next;
+    if (next != -1) hash->prev[next] = prev;
+}
+
+void InsertSpatialHash(SpatialHash *hash, int id, float x, float z) {
+    LinkId(hash, id, GetSpatialHashBucket(x, z));
+}
+
+void RemoveSpatialHash(SpatialHash *hash, int id) {
+    UnlinkId(hash, id);
+}
+
+void MoveSpatialHash(SpatialHash *hash, int id, float x, float z) {
+    int bucket = GetSpatialHashBucket(x, z);
+    if (bucket == hash->bucket[id]) return;
+    UnlinkId(hash, id);
+    LinkId(hash, id, bucket);
+}
+
+int VisitSpatialHash(const SpatialHash *hash, float x, float z, float radius, SpatialHashVisitor visit,
+                     void *context) {
+    int minCx = CellCoord(x - radius);
+    int maxCx = CellCoord(x + radius);
+    int minCz = CellCoord(z - radius);
+    int maxCz = CellCoord(z + radius);
+
+    // Never walk the same bucket twice when a huge radius wraps around the table
+    if (maxCx - minCx >= SPATIAL_HASH_DIM) maxCx = minCx + SPATIAL_HASH_DIM - 1;
+    if (maxCz - minCz >= SPATIAL_HASH_DIM) maxCz = minCz + SPATIAL_HASH_DIM - 1;
+
+    int candidates = 0;
+    bool keepGoing = true;
+    for (int cz = minCz; cz <= maxCz && keepGoing; cz++) {
+        for (int cx = minCx; cx <= maxCx && keepGoing; cx++) {
+            for (int id = hash->head[BucketOfCell(cx, cz)]; id != -1; id = hash->next[id]) {
+                candidates++;
+                if (!visit(id, context)) {
+                    keepGoing = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    return candidates;
+}
+
+void RecordSpatialHashQuery(SpatialHash *hash, int candidates) {
+    hash->stats.queries++;
+    hash->stats.candidatesTested += candidates;
+    hash->stats.lastCandidates = candidates;
+    if (candidates > hash->stats.maxCandidates) hash->stats.maxCandidates = candidates;
+}
+
+int QuerySpatialHash(SpatialHash *hash, float x, float z, float radius, SpatialHashVisitor visit, void *context) {
+    int candidates = VisitSpatialHash(hash, x, z, radius, visit, context);
+    RecordSpatialHashQuery(hash, candidates);
+    return candidates;
+}
+
+void ResetSpatialHashStats(SpatialHash *hash) {
+    hash->stats = (SpatialHashStats){0};
+}
@@ -0,0 +1,49 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <stdbool.h>
+
+#define SPATIAL_HASH_CELL_SIZE 2.0f
+// Cells wrap onto a 64x64 bucket table, so cells closer than 64 apart never share a
+// bucket. That covers the whole 100x100 arena; bigger maps only pick up extra candidates.
+#define SPATIAL_HASH_DIM 64
+#define SPATIAL_HASH_BUCKETS (SPATIAL_HASH_DIM * SPATIAL_HASH_DIM)
+
+typedef struct {
+    int queries;
+    long long candidatesTested;  // Summed over all queries since the last reset
+    int lastCandidates;          // Candidates tested by the most recent query
+    int maxCandidates;
+} SpatialHashStats;
+
+// Intrusive doubly-linked bucket lists over entity ids, so an entity moves between
+// buckets in O(1) and only when it actually crosses a cell boundary
+typedef struct {
+    int *head;    // First id per bucket, -1 when empty
+    int *next;    // Per id
+    int *prev;    // Per id, -1 when first in its bucket
+    int *bucket;  // Per id
+    int capacity;
+    SpatialHashStats stats;
+} SpatialHash;
+
+// Return false to stop the query early
+typedef bool (*SpatialHashVisitor)(int id, void *context);
+
+void InitSpatialHash(SpatialHash *hash);
+void UnloadSpatialHash(SpatialHash *hash);
+void ReserveSpatialHash(SpatialHash *hash, int capacity);
+void InsertSpatialHash(SpatialHash *hash, int id, float x, float z);
+void RemoveSpatialHash(SpatialHash *hash, int id);
+// Relinks the id only when (x, z) falls in a different bucket than before
+void MoveSpatialHash(SpatialHash *hash, int id, float x, float z);
+// Visits every id in the buckets overlapping the square around (x, z); returns candidates visited
+int QuerySpatialHash(SpatialHash *hash, float x, float z, float radius, SpatialHashVisitor visit, void *context);
+// QuerySpatialHash without touching the stats, so several threads can query at once.
+// Record the queries afterwards with RecordSpatialHashQuery.
+int VisitSpatialHash(const SpatialHash *hash, float x, float z, float radius, SpatialHashVisitor visit,
+                     void *context);
+void RecordSpatialHashQuery(SpatialHash *hash, int candidates);
+void ResetSpatialHashStats(SpatialHash *hash);
+
+#endif
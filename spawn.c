@@ -0,0 +1,185 @@
+#include "spawn.h"
+#include "rng.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPAWN_CANDIDATES 30  // Tries around each active point before it retires (Bridson's k)
+#define SPAWN_DENSITY 0.65f  // Points per spacing^2 of area that a finished fill leaves behind
+#define SPAWN_SURPLUS 1.5f   // Fill for this many points per one asked for, so which ones is random too
+#define SPAWN_SHRINK 0.7f    // Spacing factor for each retry when obstacles leave too little room
+#define SPAWN_MAX_PASSES 4
+
+typedef struct {
+    const StaticWorld *world;
+    const SpawnArea *spec;
+    Rectangle area;     // spec->area clipped to the walls
+    float spacing;
+    float cellSize;     // spacing / sqrt(2), so a cell never holds two points
+    int dimX;
+    int dimZ;
+    int *cells;         // Point in each cell, -1 when empty
+    Vector2 *points;
+    int count;
+    int capacity;
+    int *active;        // Points that may still have room around them
+    int activeCount;
+} PoissonFill;
+
+// Uniform in [0, 1)
+static float RandomUnit(uint32_t *rng) {
+    return (float)NextRandom(rng) / 2147483648.0f;
+}
+
+static bool IsSpawnAllowed(const PoissonFill *fill, float x, float z) {
+    Rectangle area = fill->area;
+    if (x < area.x || x > area.x + area.width || z < area.y || z > area.y + area.height) return false;
+
+    const SpawnArea *spec = fill->spec;
+    float dx = x - spec->avoid.x;
+    float dz = z - spec->avoid.y;
+    if (dx * dx + dz * dz < spec->avoidRadius * spec->avoidRadius) return false;
+    if (!IsWorldClearOfTrees(fill->world, x, z, spec->clearance)) return false;
+    return !CheckWorldCollisionSphere(fill->world, (Vector3){x, spec->radius, z}, spec->radius);
+}
+
+static int GetFillCoord(float v, float origin, float cellSize, int dim) {
+    int cell = (int)((v - origin) / cellSize);
+    if (cell < 0) return 0;
+    if (cell >= dim) return dim - 1;
+    return cell;
+}
+
+static bool IsFarFromPoints(const PoissonFill *fill, float x, float z) {
+    int cx = GetFillCoord(x, fill->area.x, fill->cellSize, fill->dimX);
+    int cz = GetFillCoord(z, fill->area.y, fill->cellSize, fill->dimZ);
+    // Anything closer than spacing lies at most two cells away, and never in the corners
+    // of that 5x5 block
+    int minX = cx > 2 ? cx - 2 : 0;
+    int maxX = cx + 2 < fill->dimX ? cx + 2 : fill->dimX - 1;
+    int minZ = cz > 2 ? cz - 2 : 0;
+    int maxZ = cz + 2 < fill->dimZ ? cz + 2 : fill->dimZ - 1;
+    float spacingSq = fill->spacing * fill->spacing;
+    for (int nz = minZ; nz <= maxZ; nz++) {
+        const int *row = fill->cells + nz * fill->dimX;
+        bool edgeRow = nz == cz - 2 || nz == cz + 2;
+        for (int nx = minX; nx <= maxX; nx++) {
+            if (edgeRow && (nx == cx - 2 || nx == cx + 2)) continue;
+            int point = row[nx];
+            if (point < 0) continue;
+            float dx = x - fill->points[point].x;
+            float dz = z - fill->points[point].y;
+            if (dx * dx + dz * dz < spacingSq) return false;
+        }
+    }
+    return true;
+}
+
+static void AddFillPoint(PoissonFill *fill, float x, float z) {
+    if (fill->count == fill->capacity) {
+        fill->capacity = fill->capacity > 0 ? fill->capacity * 2 : 64;
+        fill->points = realloc(fill->points, fill->capacity * sizeof(Vector2));
+        fill->active = realloc(fill->active, fill->capacity * sizeof(int));
+    }
+    int cx = GetFillCoord(x, fill->area.x, fill->cellSize, fill->dimX);
+    int cz = GetFillCoord(z, fill->area.y, fill->cellSize, fill->dimZ);
+    fill->cells[cz * fill->dimX + cx] = fill->count;
+    fill->active[fill->activeCount++] = fill->count;
+    fill->points[fill->count++] = (Vector2){x, z};
+}
+
+static bool TryAddPoint(PoissonFill *fill, float x, float z) {
+    // The spacing test is a few loads; the world queries cost far more, so they go last
+    if (!IsFarFromPoints(fill, x, z) || !IsSpawnAllowed(fill, x, z)) return false;
+    AddFillPoint(fill, x, z);
+    return true;
+}
+
+// Buckets the points kept from earlier passes for a new spacing. It is never larger than
+// theirs, so they still sit one to a cell, and each may have room around it again.
+static void ResetFillGrid(PoissonFill *fill, float spacing) {
+    fill->spacing = spacing;
+    fill->cellSize = spacing / sqrtf(2.0f);
+    fill->dimX = (int)ceilf(fill->area.width / fill->cellSize);
+    fill->dimZ = (int)ceilf(fill->area.height / fill->cellSize);
+    if (fill->dimX < 1) fill->dimX = 1;
+    if (fill->dimZ < 1) fill->dimZ = 1;
+
+    size_t cellCount = (size_t)fill->dimX * fill->dimZ;
+    fill->cells = realloc(fill->cells, cellCount * sizeof(int));
+    memset(fill->cells, 0xff, cellCount * sizeof(int));
+    for (int i = 0; i < fill->count; i++) {
+        int cx = GetFillCoord(fill->points[i].x, fill->area.x, fill->cellSize, fill->dimX);
+        int cz = GetFillCoord(fill->points[i].y, fill->area.y, fill->cellSize, fill->dimZ);
+        fill->cells[cz * fill->dimX + cx] = i;
+        fill->active[i] = i;
+    }
+    fill->activeCount = fill->count;
+}
+
+// Grows points outward from the active ones until none has room left around it
+static void RunFill(PoissonFill *fill, uint32_t *rng) {
+    // Fresh seeds each pass reach open ground the existing points cannot grow into
+    Rectangle area = fill->area;
+    for (int k = 0; k < SPAWN_CANDIDATES; k++) {
+        TryAddPoint(fill, area.x + RandomUnit(rng) * area.width, area.y + RandomUnit(rng) * area.height);
+    }
+
+    while (fill->activeCount > 0) {
+        // Newest first keeps the search among cells still in cache; Bridson picks at
+        // random, but the order does not change the spacing, only the pattern it grows in
+        int slot = fill->activeCount - 1;
+        Vector2 from = fill->points[fill->active[slot]];
+        bool placed = false;
+        for (int k = 0; k < SPAWN_CANDIDATES && !placed; k++) {
+            // Uniform over the ring between one and two spacings out
+            float angle = RandomUnit(rng) * 2.0f * PI;
+            float distance = fill->spacing * sqrtf(1.0f + 3.0f * RandomUnit(rng));
+            placed = TryAddPoint(fill, from.x + cosf(angle) * distance, from.y + sinf(angle) * distance);
+        }
+        if (!placed) fill->active[slot] = fill->active[--fill->activeCount];
+    }
+}
+
+int PlaceSpawnPoints(const StaticWorld *world, const SpawnArea *area, int count, uint32_t *rng, Vector2 *points) {
+    if (count <= 0) return 0;
+
+    float limit = world->halfSize - area->wallMargin;
+    float minX = fmaxf(area->area.x, -limit);
+    float minZ = fmaxf(area->area.y, -limit);
+    float maxX = fminf(area->area.x + area->area.width, limit);
+    float maxZ = fminf(area->area.y + area->area.height, limit);
+    if (maxX < minX) minX = maxX = fminf(fmaxf(area->area.x, -limit), limit);
+    if (maxZ < minZ) minZ = maxZ = fminf(fmaxf(area->area.y, -limit), limit);
+
+    PoissonFill fill = {0};
+    fill.world = world;
+    fill.spec = area;
+    fill.area = (Rectangle){minX, minZ, maxX - minX, maxZ - minZ};
+    float spacing = sqrtf(SPAWN_DENSITY * fill.area.width * fill.area.height / (SPAWN_SURPLUS * count));
+    if (!(spacing > area->minSpacing)) spacing = area->minSpacing;
+    if (!(spacing > 0.0f)) return 0;
+
+    // Later passes only run at a smaller spacing; once at the floor there is nothing left to try
+    for (int pass = 0; pass < SPAWN_MAX_PASSES && fill.count < count; pass++) {
+        float passSpacing = pass == 0 ? spacing : fmaxf(fill.spacing * SPAWN_SHRINK, area->minSpacing);
+        if (pass > 0 && passSpacing >= fill.spacing) break;
+        ResetFillGrid(&fill, passSpacing);
+        RunFill(&fill, rng);
+    }
+
+    // A random `count` of the points
+    int picked = count < fill.count ? count : fill.count;
+    for (int i = 0; i < picked; i++) {
+        int j = i + NextRandom(rng) % (fill.count - i);
+        Vector2 swap = fill.points[i];
+        fill.points[i] = fill.points[j];
+        fill.points[j] = swap;
+        points[i] = fill.points[i];
+    }
+
+    free(fill.cells);
+    free(fill.points);
+    free(fill.active);
+    return picked;
+}
@@ -0,0 +1,30 @@
+#ifndef SPAWN_H
+#define SPAWN_H
+
+#include "raylib.h"
+#include "world.h"
+#include <stdint.h>
+
+// Where a batch of enemies may appear, on the XZ plane
+typedef struct {
+    Rectangle area;     // Candidate region, clipped to the arena's wall margin
+    float wallMargin;   // Kept from the arena edges
+    Vector2 avoid;      // Kept avoidRadius away from this point (the player)
+    float avoidRadius;
+    float clearance;    // Kept from tree trunks
+    float radius;       // Body radius; kept out of boxes
+    float minSpacing;   // Closest two points may be; must be above 0
+} SpawnArea;
+
+// Places up to `count` points in `area` with Bridson's Poisson-disk sampling: spacing is
+// picked from the area and count so the points spread over all of it, and every point is at
+// least that far from every other. A bucket grid of spacing/sqrt(2) cells holds at most one
+// point each, so every candidate is checked against a fixed neighborhood and the whole pass
+// is linear in `count`. Points come from rng only, so a seed reproduces them exactly.
+//
+// When obstacles or the player leave too little room, spacing shrinks a few times, never
+// below minSpacing. Every point written meets every constraint; returns how many there are,
+// which is less than `count` when the area cannot hold them all.
+int PlaceSpawnPoints(const StaticWorld *world, const SpawnArea *area, int count, uint32_t *rng, Vector2 *points);
+
+#endif
@@ -0,0 +1,153 @@
+#include "ui.h"
+#include "rlgl.h"
+#include <stdio.h>
+#include <string.h>
+
+void InitUiLayer(UiLayer *ui) {
+    memset(ui, 0, sizeof(UiLayer));
+}
+
+void UnloadUiLayer(UiLayer *ui) {
+    if (ui->target.id != 0) UnloadRenderTexture(ui->target);
+    ui->target = (RenderTexture2D){0};
+}
+
+void ClearUiLayer(UiLayer *ui) {
+    ui->widgetCount = 0;
+    ui->width = GetScreenWidth();
+    ui->height = GetScreenHeight();
+    ui->dirty = true;
+}
+
+bool IsUiLayoutCurrent(const UiLayer *ui) {
+    return ui->width == GetScreenWidth() && ui->height == GetScreenHeight();
+}
+
+static UiWidget *AddUiWidget(UiLayer *ui, UiWidgetType type, Color color) {
+    if (ui->widgetCount == MAX_UI_WIDGETS) {
+        TraceLog(LOG_WARNING, "UI: More than %d widgets, the rest are not drawn", MAX_UI_WIDGETS);
+        return NULL;
+    }
+    UiWidget *widget = &ui->widgets[ui->widgetCount++];
+    memset(widget, 0, sizeof(UiWidget));
+    widget->type = type;
+    widget->visible = true;
+    widget->color = color;
+    ui->dirty = true;
+    return widget;
+}
+
+static void LayoutUiLabel(UiWidget *label) {
+    label->x = label->anchorX;
+    if (label->align == UI_ALIGN_CENTER) label->x -= MeasureText(label->text, label->fontSize) / 2;
+}
+
+int AddUiLabel(UiLayer *ui, const char *text, int fontSize, Color color, UiAlign align, int x, int y) {
+    UiWidget *label = AddUiWidget(ui, UI_WIDGET_LABEL, color);
+    if (!label) return -1;
+    snprintf(label->text, sizeof(label->text), "%s", text);
+    label->fontSize = fontSize;
+    label->align = align;
+    label->anchorX = x;
+    label->y = y;
+    LayoutUiLabel(label);
+    return (int)(label - ui->widgets);
+}
+
+int AddUiBar(UiLayer *ui, Rectangle bounds, Color color) {
+    UiWidget *bar = AddUiWidget(ui, UI_WIDGET_BAR, color);
+    if (!bar) return -1;
+    bar->bounds = bounds;
+    bar->fill = 1.0f;
+    return (int)(bar - ui->widgets);
+}
+
+void SetUiLabel(UiLayer *ui, int label, const char *format, const int *values, int valueCount) {
+    if (label < 0) return;
+    UiWidget *widget = &ui->widgets[label];
+    if (valueCount > UI_MAX_VALUES) valueCount = UI_MAX_VALUES;
+
+    bool same = widget->format == format && widget->valueCount == valueCount;
+    for (int i = 0; i < valueCount && same; i++) same = widget->values[i] == values[i];
+    if (same) return;
+
+    widget->format = format;
+    widget->valueCount = valueCount;
+    int args[UI_MAX_VALUES] = {0};
+    for (int i = 0; i < valueCount; i++) widget->values[i] = args[i] = values[i];
+    // Arguments past the ones the format uses are ignored
+    snprintf(widget->text, sizeof(widget->text), format, args[0], args[1], args[2]);
+    LayoutUiLabel(widget);
+    ui->dirty = true;
+}
+
+void SetUiColor(UiLayer *ui, int widget, Color color) {
+    if (widget < 0) return;
+    Color *current = &ui->widgets[widget].color;
+    if (current->r == color.r && current->g == color.g && current->b == color.b && current->a == color.a) return;
+    *current = color;
+    ui->dirty = true;
+}
+
+void SetUiBarFill(UiLayer *ui, int bar, float fill) {
+    if (bar < 0 || ui->widgets[bar].fill == fill) return;
+    ui->widgets[bar].fill = fill;
+    ui->dirty = true;
+}
+
+void SetUiVisible(UiLayer *ui, int widget, bool visible) {
+    if (widget < 0 || ui->widgets[widget].visible == visible) return;
+    ui->widgets[widget].visible = visible;
+    ui->dirty = true;
+}
+
+static void DrawUiBar(const UiWidget *bar) {
+    int x = (int)bar->bounds.x;
+    int y = (int)bar->bounds.y;
+    int width = (int)bar->bounds.width;
+    int height = (int)bar->bounds.height;
+    // Background, fill, border
+    DrawRectangle(x - 2, y - 2, width + 4, height + 4, DARKGRAY);
+    DrawRectangle(x, y, (int)(width * bar->fill), height, bar->color);
+    DrawRectangleLines(x - 2, y - 2, width + 4, height + 4, WHITE);
+}
+
+static void RenderUiLayer(UiLayer *ui) {
+    BeginTextureMode(ui->target);
+    ClearBackground(BLANK);
+    // Colour is blended as usual, which leaves it premultiplied in the texture, while alpha
+    // accumulates as coverage so antialiased text edges keep their weight when composited
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD,
+                              RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    for (int i = 0; i < ui->widgetCount; i++) {
+        const UiWidget *widget = &ui->widgets[i];
+        if (!widget->visible) continue;
+        if (widget->type == UI_WIDGET_BAR) {
+            DrawUiBar(widget);
+        } else {
+            DrawText(widget->text, widget->x, widget->y, widget->fontSize, widget->color);
+        }
+    }
+    EndBlendMode();
+    EndTextureMode();
+    ui->renders++;
+}
+
+void DrawUiLayer(UiLayer *ui) {
+    if (ui->target.id == 0 || ui->target.texture.width != ui->width || ui->target.texture.height != ui->height) {
+        UnloadUiLayer(ui);
+        ui->target = LoadRenderTexture(ui->width, ui->height);
+        ui->dirty = true;
+    }
+    if (ui->dirty) {
+        RenderUiLayer(ui);
+        ui->dirty = false;
+    }
+
+    // Render textures are stored bottom-up, hence the negative height
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(ui->target.texture, (Rectangle){0, 0, (float)ui->width, -(float)ui->height}, (Vector2){0, 0},
+                   WHITE);
+    EndBlendMode();
+}
@@ -0,0 +1,73 @@
+#ifndef UI_H
+#define UI_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define MAX_UI_WIDGETS 32
+#define UI_TEXT_SIZE 96
+#define UI_MAX_VALUES 3  // Ints a label's format may take
+
+typedef enum {
+    UI_ALIGN_LEFT,    // x is the left edge of the text
+    UI_ALIGN_CENTER   // x is the middle of the text
+} UiAlign;
+
+typedef enum {
+    UI_WIDGET_LABEL,
+    UI_WIDGET_BAR
+} UiWidgetType;
+
+// One retained element. A label keeps its formatted text and where it lands, so it is
+// formatted and measured again only when what it is bound to changes.
+typedef struct {
+    UiWidgetType type;
+    bool visible;
+    Color color;
+    // Label
+    char text[UI_TEXT_SIZE];
+    const char *format;          // Last format bound, compared by pointer
+    int values[UI_MAX_VALUES];   // Last values bound
+    int valueCount;
+    int fontSize;
+    UiAlign align;
+    int anchorX;
+    int x;                       // Left edge of the text as last measured
+    int y;
+    // Bar
+    Rectangle bounds;            // Inside the border
+    float fill;                  // 0 to 1
+} UiWidget;
+
+// Widgets drawn into a screen-sized texture that is redrawn only after one of them changes.
+// Every other frame the layer costs one textured quad, however many widgets it holds.
+typedef struct {
+    RenderTexture2D target;
+    int width;                   // Screen size the widgets were laid out for
+    int height;
+    UiWidget widgets[MAX_UI_WIDGETS];
+    int widgetCount;
+    bool dirty;
+    int renders;                 // Times the texture was redrawn, for the profiler overlay
+} UiLayer;
+
+void InitUiLayer(UiLayer *ui);
+void UnloadUiLayer(UiLayer *ui);
+// Removes every widget, to lay out a new screen at the current screen size
+void ClearUiLayer(UiLayer *ui);
+// False once the screen size no longer matches the one the widgets were laid out for
+bool IsUiLayoutCurrent(const UiLayer *ui);
+// Both return the widget's index, or -1 when all MAX_UI_WIDGETS are in use; the setters
+// ignore -1
+int AddUiLabel(UiLayer *ui, const char *text, int fontSize, Color color, UiAlign align, int x, int y);
+int AddUiBar(UiLayer *ui, Rectangle bounds, Color color);
+// Binds a label to `format` and up to UI_MAX_VALUES ints. Nothing is formatted or measured
+// unless the format pointer or a value differs from the last call, so pass string literals.
+void SetUiLabel(UiLayer *ui, int label, const char *format, const int *values, int valueCount);
+void SetUiColor(UiLayer *ui, int widget, Color color);
+void SetUiBarFill(UiLayer *ui, int bar, float fill);
+void SetUiVisible(UiLayer *ui, int widget, bool visible);
+// Redraws the texture if any widget changed, then draws it over the screen
+void DrawUiLayer(UiLayer *ui);
+
+#endif
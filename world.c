@@ -0,0 +1,250 @@
+#include "world.h"
+#include <stdlib.h>
+#include <math.h>
+
+StaticWorld BuildArenaWorld(void) {
+    StaticWorld world = {0};
+    world.halfSize = ARENA_HALF_SIZE;
+
+    // 20 trees in a 5x4 grid
+    for (int i = 0; i < 20; i++) {
+        float x = (i % 5) * 15.0f - 30.0f;
+        float z = (i / 5) * 15.0f - 30.0f;
+        float height = 2.0f + (i % 3);
+        AddWorldTree(&world, x, z, height);
+    }
+
+    // North, east, west and south walls
+    AddWorldBox(&world, (BoundingBox){{-50.0f, 0.0f, -51.0f}, {50.0f, 1.0f, -49.0f}}, DARKGRAY);
+    AddWorldBox(&world, (BoundingBox){{49.0f, 0.0f, -50.0f}, {51.0f, 1.0f, 50.0f}}, DARKGRAY);
+    AddWorldBox(&world, (BoundingBox){{-51.0f, 0.0f, -50.0f}, {-49.0f, 1.0f, 50.0f}}, DARKGRAY);
+    AddWorldBox(&world, (BoundingBox){{-50.0f, 0.0f, 49.0f}, {50.0f, 1.0f, 51.0f}}, DARKGRAY);
+
+    BuildWorldGrid(&world);
+    return world;
+}
+
+void UnloadStaticWorld(StaticWorld *world) {
+    if (world->borrowed) {
+        *world = (StaticWorld){0};
+        return;
+    }
+
+    free(world->boxes);
+    free(world->trees);
+    free(world->chunkBoxStart);
+    free(world->boxCellStart);
+    free(world->boxCellItems);
+    free(world->treeCellStart);
+    free(world->treeCellItems);
+    *world = (StaticWorld){0};
+}
+
+void AddWorldBox(StaticWorld *world, BoundingBox box, Color color) {
+    if (world->boxCount == world->boxCapacity) {
+        world->boxCapacity = world->boxCapacity > 0 ? world->boxCapacity * 2 : 64;
+        world->boxes = realloc(world->boxes, world->boxCapacity * sizeof(WorldBox));
+    }
+    world->boxes[world->boxCount++] = (WorldBox){box, color};
+}
+
+void AddWorldTree(StaticWorld *world, float x, float z, float height) {
+    // Trunk (1x1xheight) with a 3x3x3 foliage cube on top
+    AddWorldBox(world, (BoundingBox){{x - 0.5f, 0.0f, z - 0.5f}, {x + 0.5f, height, z + 0.5f}}, BROWN);
+    AddWorldBox(world, (BoundingBox){{x - 1.5f, height, z - 1.5f}, {x + 1.5f, height + 3.0f, z + 1.5f}}, DARKGREEN);
+
+    if (world->treeCount == world->treeCapacity) {
+        world->treeCapacity = world->treeCapacity > 0 ? world->treeCapacity * 2 : 64;
+        world->trees = realloc(world->trees, world->treeCapacity * sizeof(Vector2));
+    }
+    world->trees[world->treeCount++] = (Vector2){x, z};
+}
+
+static int ClampCell(const StaticWorld *world, float v) {
+    int cell = (int)floorf((v + world->halfSize) / WORLD_CELL_SIZE);
+    if (cell < 0) return 0;
+    if (cell >= world->gridDim) return world->gridDim - 1;
+    return cell;
+}
+
+WorldCellRange GetWorldCellRange(const StaticWorld *world, float x, float z, float radius) {
+    return (WorldCellRange){
+        ClampCell(world, x - radius),
+        ClampCell(world, z - radius),
+        ClampCell(world, x + radius),
+        ClampCell(world, z + radius)
+    };
+}
+
+int GetWorldCell(const StaticWorld *world, int cx, int cz) {
+    int chunk = (cz / WORLD_CHUNK_CELLS) * world->chunkDim + cx / WORLD_CHUNK_CELLS;
+    return (chunk * WORLD_CHUNK_CELLS + cz % WORLD_CHUNK_CELLS) * WORLD_CHUNK_CELLS + cx % WORLD_CHUNK_CELLS;
+}
+
+int GetWorldChunkCoord(const StaticWorld *world, float v) {
+    return ClampCell(world, v) / WORLD_CHUNK_CELLS;
+}
+
+WorldChunkRange GetWorldChunkRange(const StaticWorld *world, float x, float z, int radius) {
+    int cx = GetWorldChunkCoord(world, x);
+    int cz = GetWorldChunkCoord(world, z);
+    WorldChunkRange range = {cx - radius, cz - radius, cx + radius, cz + radius};
+    if (range.minX < 0) range.minX = 0;
+    if (range.minZ < 0) range.minZ = 0;
+    if (range.maxX >= world->chunkDim) range.maxX = world->chunkDim - 1;
+    if (range.maxZ >= world->chunkDim) range.maxZ = world->chunkDim - 1;
+    return range;
+}
+
+Rectangle GetWorldChunkBounds(const StaticWorld *world, int chunkX, int chunkZ) {
+    return (Rectangle){-world->halfSize + chunkX * WORLD_CHUNK_SIZE, -world->halfSize + chunkZ * WORLD_CHUNK_SIZE,
+                       WORLD_CHUNK_SIZE, WORLD_CHUNK_SIZE};
+}
+
+Rectangle GetWorldChunkRangeBounds(const StaticWorld *world, WorldChunkRange range) {
+    Rectangle bounds = GetWorldChunkBounds(world, range.minX, range.minZ);
+    bounds.width = (range.maxX - range.minX + 1) * WORLD_CHUNK_SIZE;
+    bounds.height = (range.maxZ - range.minZ + 1) * WORLD_CHUNK_SIZE;
+    return bounds;
+}
+
+static int BoxChunk(const StaticWorld *world, BoundingBox b) {
+    int cx = GetWorldChunkCoord(world, (b.min.x + b.max.x) / 2.0f);
+    int cz = GetWorldChunkCoord(world, (b.min.z + b.max.z) / 2.0f);
+    return cz * world->chunkDim + cx;
+}
+
+void BuildWorldGrid(StaticWorld *world) {
+    world->chunkDim = (int)ceilf(2.0f * world->halfSize / WORLD_CHUNK_SIZE);
+    world->gridDim = world->chunkDim * WORLD_CHUNK_CELLS;
+    int cellCount = world->gridDim * world->gridDim;
+    int chunkCount = world->chunkDim * world->chunkDim;
+
+    // Boxes: stable counting sort by chunk, so each chunk's boxes are one range
+    world->chunkBoxStart = calloc(chunkCount + 1, sizeof(int));
+    for (int i = 0; i < world->boxCount; i++) world->chunkBoxStart[BoxChunk(world, world->boxes[i].box) + 1]++;
+    for (int c = 0; c < chunkCount; c++) world->chunkBoxStart[c + 1] += world->chunkBoxStart[c];
+
+    WorldBox *sorted = malloc((world->boxCount + 1) * sizeof(WorldBox));
+    int *chunkFill = malloc(chunkCount * sizeof(int));
+    for (int c = 0; c < chunkCount; c++) chunkFill[c] = world->chunkBoxStart[c];
+    for (int i = 0; i < world->boxCount; i++) sorted[chunkFill[BoxChunk(world, world->boxes[i].box)]++] = world->boxes[i];
+    free(chunkFill);
+    free(world->boxes);
+    world->boxes = sorted;
+    world->boxCapacity = world->boxCount + 1;
+
+    // Boxes: count per cell, prefix sum into offsets, then fill (compressed sparse rows)
+    world->boxCellStart = calloc(cellCount + 1, sizeof(int));
+    for (int i = 0; i < world->boxCount; i++) {
+        BoundingBox b = world->boxes[i].box;
+        int minX = ClampCell(world, b.min.x), maxX = ClampCell(world, b.max.x);
+        int minZ = ClampCell(world, b.min.z), maxZ = ClampCell(world, b.max.z);
+        for (int cz = minZ; cz <= maxZ; cz++) {
+            for (int cx = minX; cx <= maxX; cx++) world->boxCellStart[GetWorldCell(world, cx, cz) + 1]++;
+        }
+    }
+    for (int c = 0; c < cellCount; c++) world->boxCellStart[c + 1] += world->boxCellStart[c];
+
+    world->boxCellItems = malloc((world->boxCellStart[cellCount] + 1) * sizeof(int));
+    int *fill = malloc(cellCount * sizeof(int));
+    for (int c = 0; c < cellCount; c++) fill[c] = world->boxCellStart[c];
+    for (int i = 0; i < world->boxCount; i++) {
+        BoundingBox b = world->boxes[i].box;
+        int minX = ClampCell(world, b.min.x), maxX = ClampCell(world, b.max.x);
+        int minZ = ClampCell(world, b.min.z), maxZ = ClampCell(world, b.max.z);
+        for (int cz = minZ; cz <= maxZ; cz++) {
+            for (int cx = minX; cx <= maxX; cx++) world->boxCellItems[fill[GetWorldCell(world, cx, cz)]++] = i;
+        }
+    }
+
+    // Trees: each trunk center lands in exactly one cell
+    world->treeCellStart = calloc(cellCount + 1, sizeof(int));
+    for (int i = 0; i < world->treeCount; i++) {
+        int cell = GetWorldCell(world, ClampCell(world, world->trees[i].x), ClampCell(world, world->trees[i].y));
+        world->treeCellStart[cell + 1]++;
+    }
+    for (int c = 0; c < cellCount; c++) world->treeCellStart[c + 1] += world->treeCellStart[c];
+
+    world->treeCellItems = malloc((world->treeCount + 1) * sizeof(int));
+    for (int c = 0; c < cellCount; c++) fill[c] = world->treeCellStart[c];
+    for (int i = 0; i < world->treeCount; i++) {
+        int cell = GetWorldCell(world, ClampCell(world, world->trees[i].x), ClampCell(world, world->trees[i].y));
+        world->treeCellItems[fill[cell]++] = i;
+    }
+    free(fill);
+}
+
+bool CheckWorldCollisionSphere(const StaticWorld *world, Vector3 center, float radius) {
+    WorldCellRange range = GetWorldCellRange(world, center.x, center.z, radius);
+    for (int cz = range.minZ; cz <= range.maxZ; cz++) {
+        for (int cx = range.minX; cx <= range.maxX; cx++) {
+            int cell = GetWorldCell(world, cx, cz);
+            for (int k = world->boxCellStart[cell]; k < world->boxCellStart[cell + 1]; k++) {
+                if (CheckCollisionBoxSphere(world->boxes[world->boxCellItems[k]].box, center, radius)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Slab test of the segment origin + t*delta against one axis of an inflated box
+static bool ClipSlab(float origin, float delta, float min, float max, float *tEnter, float *tExit) {
+    if (fabsf(delta) < 1e-8f) return origin >= min && origin <= max;
+
+    float t1 = (min - origin) / delta;
+    float t2 = (max - origin) / delta;
+    if (t1 > t2) {
+        float tmp = t1;
+        t1 = t2;
+        t2 = tmp;
+    }
+    if (t1 > *tEnter) *tEnter = t1;
+    if (t2 < *tExit) *tExit = t2;
+    return *tEnter <= *tExit;
+}
+
+float SweepWorldSphere(const StaticWorld *world, Vector3 start, Vector3 end, float radius) {
+    Vector3 delta = {end.x - start.x, end.y - start.y, end.z - start.z};
+    float midX = (start.x + end.x) / 2.0f;
+    float midZ = (start.z + end.z) / 2.0f;
+    float reach = fmaxf(fabsf(delta.x), fabsf(delta.z)) / 2.0f + radius;
+
+    float earliest = 2.0f;
+    WorldCellRange range = GetWorldCellRange(world, midX, midZ, reach);
+    for (int cz = range.minZ; cz <= range.maxZ; cz++) {
+        for (int cx = range.minX; cx <= range.maxX; cx++) {
+            int cell = GetWorldCell(world, cx, cz);
+            for (int k = world->boxCellStart[cell]; k < world->boxCellStart[cell + 1]; k++) {
+                BoundingBox b = world->boxes[world->boxCellItems[k]].box;
+                float tEnter = 0.0f;
+                float tExit = 1.0f;
+                if (ClipSlab(start.x, delta.x, b.min.x - radius, b.max.x + radius, &tEnter, &tExit) &&
+                    ClipSlab(start.y, delta.y, b.min.y - radius, b.max.y + radius, &tEnter, &tExit) &&
+                    ClipSlab(start.z, delta.z, b.min.z - radius, b.max.z + radius, &tEnter, &tExit) &&
+                    tEnter < earliest) {
+                    earliest = tEnter;
+                }
+            }
+        }
+    }
+    return earliest;
+}
+
+bool IsWorldClearOfTrees(const StaticWorld *world, float x, float z, float clearance) {
+    WorldCellRange range = GetWorldCellRange(world, x, z, clearance);
+    for (int cz = range.minZ; cz <= range.maxZ; cz++) {
+        for (int cx = range.minX; cx <= range.maxX; cx++) {
+            int cell = GetWorldCell(world, cx, cz);
+            for (int k = world->treeCellStart[cell]; k < world->treeCellStart[cell + 1]; k++) {
+                Vector2 tree = world->trees[world->treeCellItems[k]];
+                float dx = x - tree.x;
+                float dz = z - tree.y;
+                if (dx * dx + dz * dz < clearance * clearance) return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+#define WORLD_CELL_SIZE 5.0f
+#define WORLD_CHUNK_CELLS 5  // Grid cells per chunk side
+#define WORLD_CHUNK_SIZE (WORLD_CELL_SIZE * WORLD_CHUNK_CELLS)
+#define WORLD_STREAM_RADIUS 3  // Chunks either side of the player's that are simulated and drawn
+#define ARENA_HALF_SIZE 50.0f
+
+typedef struct {
+    BoundingBox box;
+    Color color;
+} WorldBox;
+
+// Inclusive range of grid cells, already clamped to the grid
+typedef struct {
+    int minX;
+    int minZ;
+    int maxX;
+    int maxZ;
+} WorldCellRange;
+
+// Inclusive range of chunks, already clamped to the world
+typedef struct {
+    int minX;
+    int minZ;
+    int maxX;
+    int maxZ;
+} WorldChunkRange;
+
+// Static level geometry, built once at level load. Solid boxes (trunks, foliage, walls)
+// and tree trunk centers are bucketed into a uniform grid so every query only looks
+// at the obstacles in the cells it touches.
+//
+// The grid is split into WORLD_CHUNK_SIZE chunks for streaming. Cells are stored chunk
+// by chunk and boxes are sorted by the chunk holding their center, so everything one
+// chunk needs sits in a few contiguous ranges that can be paged in and out together.
+typedef struct {
+    WorldBox *boxes;
+    int boxCount;
+    Vector2 *trees;       // Trunk centers on the XZ plane, for spawn clearance
+    int treeCount;
+    float halfSize;       // Arena spans [-halfSize, halfSize] on X and Z
+    int gridDim;          // Cells per side, a whole number of chunks
+    int chunkDim;         // Chunks per side
+    int *chunkBoxStart;   // chunkDim*chunkDim + 1 offsets into boxes
+    int *boxCellStart;    // gridDim*gridDim + 1 offsets into boxCellItems
+    int *boxCellItems;    // Box indices; a box is listed in every cell it overlaps
+    int *treeCellStart;   // gridDim*gridDim + 1 offsets into treeCellItems
+    int *treeCellItems;   // Tree indices; a tree is listed in the cell holding its center
+    int boxCapacity;
+    int treeCapacity;
+    bool borrowed;        // Arrays belong to a loaded level file and are not freed here
+} StaticWorld;
+
+// The default arena: 20 trees in a 5x4 grid inside four walls
+StaticWorld BuildArenaWorld(void);
+void UnloadStaticWorld(StaticWorld *world);
+
+// Building blocks for custom arenas; call BuildWorldGrid once after adding everything
+void AddWorldBox(StaticWorld *world, BoundingBox box, Color color);
+void AddWorldTree(StaticWorld *world, float x, float z, float height);
+void BuildWorldGrid(StaticWorld *world);
+
+WorldCellRange GetWorldCellRange(const StaticWorld *world, float x, float z, float radius);
+// Index of cell (cx, cz) in the cell arrays
+int GetWorldCell(const StaticWorld *world, int cx, int cz);
+int GetWorldChunkCoord(const StaticWorld *world, float v);
+// Chunks within `radius` chunks of the one holding (x, z)
+WorldChunkRange GetWorldChunkRange(const StaticWorld *world, float x, float z, int radius);
+// World-space bounds of a chunk on the XZ plane
+Rectangle GetWorldChunkBounds(const StaticWorld *world, int chunkX, int chunkZ);
+Rectangle GetWorldChunkRangeBounds(const StaticWorld *world, WorldChunkRange range);
+bool CheckWorldCollisionSphere(const StaticWorld *world, Vector3 center, float radius);
+// Earliest fraction of start->end at which a moving sphere touches a box, or a value
+// above 1 when the path is clear. Boxes are inflated by the radius, which is exact on
+// faces and slightly conservative at edges and corners.
+float SweepWorldSphere(const StaticWorld *world, Vector3 start, Vector3 end, float radius);
+// True when no tree trunk lies within `clearance` of (x, z) on the XZ plane
+bool IsWorldClearOfTrees(const StaticWorld *world, float x, float z, float clearance);
+
+#endif